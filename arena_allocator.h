@@ -0,0 +1,153 @@
+#ifndef ARENA_ALLOCATOR_H
+#define ARENA_ALLOCATOR_H
+
+#include "allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// 单调内存区：只向前分配，释放时整块归还
+class Arena{
+public:
+    // initial_chunk 为第一块 chunk 的大小，之后每块按两倍增长
+    explicit Arena(size_t initial_chunk = 4096) : M_next_chunk(initial_chunk ? initial_chunk : 4096) {}
+
+    // 使用调用者提供的缓冲区（例如栈上数组）作为第一块，用完后再向堆申请
+    Arena(void* buffer, size_t size) : M_cur(static_cast<char*>(buffer)), M_end(static_cast<char*>(buffer) + size),
+                                       M_buffer(static_cast<char*>(buffer)), M_buffer_end(static_cast<char*>(buffer) + size),
+                                       M_next_chunk(size ? size * 2 : 4096) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena(){
+        release();
+    }
+
+    // 分配 bytes 字节，按 align 对齐
+    void* allocate(size_t bytes, size_t align = alignof(max_align_t)){
+        char* p = S_align_up(M_cur, align);
+        if (M_cur == nullptr || p + bytes > M_end) {
+            M_new_chunk(bytes + align);
+            p = S_align_up(M_cur, align);
+        }
+        M_cur = p + bytes;
+        return p;
+    }
+
+    // 一次性归还所有 chunk，之前分配的内存全部失效；调用者提供的缓冲区可以继续使用
+    void release() noexcept {
+        while (M_chunks) {
+            Chunk_header* next = M_chunks->M_next;
+            operator delete(M_chunks);
+            M_chunks = next;
+        }
+        M_cur = M_buffer;
+        M_end = M_buffer_end;
+        M_reserved = 0;
+    }
+
+    // 已向堆申请的总字节数
+    size_t reserved_bytes() const noexcept {
+        return M_reserved;
+    }
+
+private:
+    struct Chunk_header{
+        Chunk_header* M_next;
+        size_t        M_size;
+    };
+
+    static char* S_align_up(char* p, size_t align) noexcept {
+        uintptr_t v = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((v + align - 1) & ~(uintptr_t(align) - 1));
+    }
+
+    void M_new_chunk(size_t min_bytes){
+        size_t size = M_next_chunk;
+        while (size < min_bytes + sizeof(Chunk_header)) size *= 2;
+        Chunk_header* chunk = static_cast<Chunk_header*>(operator new(size));
+        chunk->M_next = M_chunks;
+        chunk->M_size = size;
+        M_chunks = chunk;
+        M_reserved += size;
+        M_cur = reinterpret_cast<char*>(chunk + 1);
+        M_end = reinterpret_cast<char*>(chunk) + size;
+        M_next_chunk = size * 2;
+    }
+
+    char*         M_cur = nullptr;      // 当前 chunk 中下一个空闲字节
+    char*         M_end = nullptr;      // 当前 chunk 的末尾
+    char*         M_buffer = nullptr;   // 调用者提供的初始缓冲区
+    char*         M_buffer_end = nullptr;
+    Chunk_header* M_chunks = nullptr;   // 已申请的 chunk 链
+    size_t        M_next_chunk;         // 下一个 chunk 的大小
+    size_t        M_reserved = 0;
+};
+
+// 从 Arena 分配的分配器，deallocate 为空操作，内存随 Arena::release() 或 Arena 析构一起释放。
+// 默认构造（未绑定 Arena）时退化为 operator new/delete。
+template <typename T>
+class Arena_allocator{
+public:
+    using value_type = T;
+    // 定义传播特性：容器拷贝时不携带 Arena，移动与交换时随容器一起转移
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    Arena_allocator() noexcept = default;
+
+    Arena_allocator(Arena& arena) noexcept : M_arena(&arena) {}
+
+    // 支持 rebind
+    template <typename U>
+    struct rebind {
+        using other = Arena_allocator<U>;
+    };
+
+    template<typename U>
+    Arena_allocator(const Arena_allocator<U>& other) noexcept : M_arena(other.arena()) {}
+
+    //分配内存
+    T* allocate(size_t n) const {
+        if (M_arena) {
+            return static_cast<T*>(M_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(operator new(n * sizeof(T)));
+    }
+
+    //释放内存：绑定 Arena 时不做任何事
+    void deallocate(T* p, size_t) const noexcept {
+        if (!M_arena) {
+            operator delete(p);
+        }
+    }
+
+    //构造对象
+    template <typename... Args>
+    void construct(T* p, Args&&... args) const {
+        new(p) T(forward<Args>(args)...);
+    }
+
+    //销毁对象
+    void destroy(T* p) const {
+        p->~T();
+    }
+
+    Arena* arena() const noexcept {
+        return M_arena;
+    }
+
+    // 比较操作：同一个 Arena 分配的内存可以互相释放
+    template <typename U>
+    bool operator==(const Arena_allocator<U>& other) const noexcept { return M_arena == other.arena(); }
+    template <typename U>
+    bool operator!=(const Arena_allocator<U>& other) const noexcept { return M_arena != other.arena(); }
+
+private:
+    Arena* M_arena = nullptr;
+};
+
+#endif // ARENA_ALLOCATOR_H
@@ -2,41 +2,74 @@
 #define BASIC_STRING_H
 
 #include <bits/char_traits.h>
-#include <unordered_set>
+#include <functional>
+#include <string_view>
 #include "vector.h"
 #include "allocator.h"
+#include "growth_policy.h"
+#include "string_search.h"
 
 
-template <class CharType, class Traits = char_traits<CharType>, class Alloc = Allocator<CharType>>
+// Growth 为扩容策略，见 growth_policy.h
+template <class CharType, class Traits = char_traits<CharType>, class Alloc = Allocator<CharType>,
+          class Growth = Growth_double>
 class Basic_string{
 
 private:
-    CharType* data_  = nullptr;
+    // 短字符串直接存放在对象内部的 local_buf_ 中，不向分配器申请内存
+    static constexpr size_t S_local_capacity = 15 / sizeof(CharType);
+
+    CharType* data_  = local_buf_;
     size_t size_     = 0;
-    size_t capacity_ = 0;
-    Alloc allocator_;
+    size_t capacity_ = S_local_capacity;
+    [[__no_unique_address__]] Alloc allocator_;
+    CharType local_buf_[S_local_capacity + 1];
+
+    bool is_local() const noexcept { return data_ == local_buf_; }
 
-    size_t strlen(const char *str) const {
-        const char *p = str;
-        while (*p != '\0') {
-            p++;
+    // 申请能容纳 capacity 个字符的存储：放得下时使用内部缓冲区，并把 capacity 调整为实际容量
+    CharType* create_storage(size_t& capacity) {
+        if (capacity <= S_local_capacity) {
+            capacity = S_local_capacity;
+            return local_buf_;
         }
-        return p - str;
+        return allocator_.allocate(capacity);
     }
 
-        // 扩容策略：双倍当前容量（至少为1
-    void expand_capacity() {
-        size_t new_capacity = (capacity_ == 0) ? 1 : capacity_ * 2;
-        CharType* new_data = allocator_.allocate(new_capacity);
-        
-        for (size_t i = 0; i < size_; ++i) {
-            new_data[i] =  std::move(data_[i]);
-            allocator_.destroy(data_ + i);
+    // 归还堆上的存储（内部缓冲区无需释放）
+    void dispose_storage() noexcept {
+        if (!is_local()) {
+            allocator_.deallocate(data_, capacity_);
         }
-        
-        allocator_.deallocate(data_, capacity_);
-        data_ = new_data;
-        capacity_ = new_capacity;
+    }
+
+    // 把 other 的内容转移过来，other 变为空串；调用前本对象不持有堆内存
+    void steal_from(Basic_string& other) noexcept {
+        if (other.is_local()) {
+            data_ = local_buf_;
+            capacity_ = S_local_capacity;
+            for (size_t i = 0; i < other.size_; ++i) {
+                local_buf_[i] = other.local_buf_[i];
+            }
+        }
+        else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+        }
+        size_ = other.size_;
+        other.data_ = other.local_buf_;
+        other.size_ = 0;
+        other.capacity_ = S_local_capacity;
+    }
+
+    size_t strlen(const CharType *str) const {
+        return Traits::length(str);
+    }
+
+    // 扩容：至少容纳 required 个字符，按 Growth 预留余量（从内部缓冲区的容量开始）。
+    // 批量追加、插入一次算出最终长度，整次调用最多重新分配一次
+    void expand_capacity(size_t required = 0) {
+        reserve(Growth::S_grow(capacity_, std::max(required, size_ + 1), sizeof(CharType)));
     }
 
     // 通用构造辅助函数
@@ -44,10 +77,10 @@ private:
     void construct_from_range(Input first, Input last) {
         for(Input it = first; it != last; it++){
             ++size_;
-            ++capacity_;
         }
 
-        data_ = allocator_.allocate(capacity_);
+        capacity_ = size_;
+        data_ = create_storage(capacity_);
         
         for (size_t i = 0; first != last; ++first, ++i) {
             allocator_.construct(data_ + i, *first);
@@ -108,18 +141,16 @@ public:
     
     Basic_string(const Basic_string& other) : 
     size_(other.size_), capacity_(other.size_), allocator_(other.allocator_) {
-        data_ = allocator_.allocate(capacity_);
+        data_ = create_storage(capacity_);
         size_t i = 0;
-        for(typename Basic_string<CharType>::const_iterator it = other.cbegin(); it != other.cend(); ++it){
+        for(const_iterator it = other.cbegin(); it != other.cend(); ++it){
             data_[i] = *it;
             i++;
         }
     }
 
-    Basic_string(Basic_string&& other) noexcept : 
-    data_(other.data_), size_(other.size_), capacity_(other.capacity_), allocator_(std::move(other.allocator_)) {
-        other.data_ = nullptr;
-        other.size_ = other.capacity_ = 0;
+    Basic_string(Basic_string&& other) noexcept : allocator_(std::move(other.allocator_)) {
+        steal_from(other);
     }
 
     Basic_string(const Basic_string& right, size_type right_offset, size_type count = npos) 
@@ -130,7 +161,7 @@ public:
         }
         size_ = count;
         capacity_ = count;
-        data_ = allocator_.allocate(capacity_);
+        data_ = create_storage(capacity_);
         for(size_type i = 0; i < count; i++) {
             data_[i] = right.data_[i + right_offset];
         }
@@ -144,14 +175,14 @@ public:
         } 
         size_ = count;
         capacity_ = count;
-        data_ = allocator_.allocate(capacity_);
+        data_ = create_storage(capacity_);
         for(size_type i = 0; i < count; i++){
             data_[i] = right[i + right_offset];
         }
     }
 
     Basic_string(const value_type* ptr, size_type count) : size_(count), capacity_(count) {
-        data_ = allocator_.allocate(capacity_);
+        data_ = create_storage(capacity_);
         for(size_type i = 0; i < count; i++){
             data_[i] = ptr[i];
         }
@@ -159,14 +190,14 @@ public:
 
     Basic_string(const value_type* ptr, size_type count, const Alloc& alloc_type) :
     size_(count), capacity_(count), allocator_(alloc_type) {
-        data_ = allocator_.allocate(capacity_);
+        data_ = create_storage(capacity_);
         for(size_type i = 0; i < count; i++){
             data_[i] = ptr[i];
         }
     }
 
     Basic_string(size_type count, value_type char_value) : size_(count), capacity_(count) {
-        data_ = allocator_.allocate(capacity_);
+        data_ = create_storage(capacity_);
         for(size_t i = 0; i < count; i++){
             data_[i] = char_value;
         }
@@ -174,7 +205,7 @@ public:
 
     Basic_string(size_type count, value_type char_value, const Alloc& alloc_type): 
     size_(count), capacity_(count), allocator_(alloc_type){
-        data_ = allocator_.allocate(capacity_);
+        data_ = create_storage(capacity_);
         for(size_t i = 0; i < count; i++){
             data_[i] = char_value;
         }
@@ -210,9 +241,9 @@ public:
         size_ = other.size_; 
         capacity_ = other.size_;
         allocator_ = other.allocator_;
-        data_ = allocator_.allocate(capacity_);
+        data_ = create_storage(capacity_);
         size_t i = 0;
-        for(typename Basic_string<CharType>::const_iterator it = other.cbegin(); it != other.cend(); ++it){
+        for(const_iterator it = other.cbegin(); it != other.cend(); ++it){
             data_[i] = *it;
             i++;
         }
@@ -221,12 +252,8 @@ public:
 
     Basic_string& operator=(Basic_string&& right){
         clear();
-        data_ = right.data_;
-        size_ = right.size_;
-        capacity_ = right.capacity_;
         allocator_ = right.allocator_;
-        right.data_ = nullptr;
-        right.capacity_ = right.size_ = 0;
+        steal_from(right);
         return *this;
     }
 
@@ -239,7 +266,7 @@ public:
         return append(ptr);
     }
 
-    Basic_string& operator+=(const Basic_string<CharType, Traits, Alloc>& right){
+    Basic_string& operator+=(const Basic_string<CharType, Traits, Alloc, Growth>& right){
         return append(right);
     }
 
@@ -308,9 +335,10 @@ public:
         for (size_t i = 0; i < size_; ++i) {
             allocator_.destroy(data_ + i);
         }
-        allocator_.deallocate(data_, capacity_);
-        data_ = nullptr;
-        size_ = capacity_ = 0;
+        dispose_storage();
+        data_ = local_buf_;
+        size_ = 0;
+        capacity_ = S_local_capacity;
     }
 
     size_t size() const { return size_; }
@@ -327,18 +355,18 @@ public:
             allocator_.destroy(data_ + i);
         }
         
-        allocator_.deallocate(data_, capacity_);
+        dispose_storage();
         data_ = new_data;
         capacity_ = new_capacity;
     }
 
     //向字符串的末尾添加字符
-    Basic_string<CharType, Traits, Alloc>& append(const value_type* ptr){
+    Basic_string<CharType, Traits, Alloc, Growth>& append(const value_type* ptr){
         return append(ptr, strlen(ptr));
     }
 
-    Basic_string<CharType, Traits, Alloc>& append(const value_type* ptr, size_type count){
-        if (size_ + count > capacity_) reserve(size_ + count);
+    Basic_string<CharType, Traits, Alloc, Growth>& append(const value_type* ptr, size_type count){
+        if (size_ + count > capacity_) expand_capacity(size_ + count);
         
         for (size_t i = 0; i < count; ++i) {
             data_[i + size_] = ptr[i];
@@ -347,11 +375,11 @@ public:
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& append(const Basic_string<CharType, Traits, Alloc>& str, 
+    Basic_string<CharType, Traits, Alloc, Growth>& append(const Basic_string<CharType, Traits, Alloc, Growth>& str, 
     size_type offset, size_type count){
         count = count > str.size_ ? str.size_ : count;
-        while(size_ + count > capacity_) { 
-            expand_capacity();
+        if(size_ + count > capacity_) {
+            expand_capacity(size_ + count);
         }
         for(size_type i = 0; i < count && i < str.size(); i++){
             data_[i + size_] = str[i + offset];
@@ -360,13 +388,13 @@ public:
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& append(const Basic_string<CharType, Traits, Alloc>& str){
+    Basic_string<CharType, Traits, Alloc, Growth>& append(const Basic_string<CharType, Traits, Alloc, Growth>& str){
         return this->append(str, 0, str.size());
     }
 
-    Basic_string<CharType, Traits, Alloc>& append(size_type count, value_type char_value){
-        while(size_ + count > capacity_) { 
-            expand_capacity();
+    Basic_string<CharType, Traits, Alloc, Growth>& append(size_type count, value_type char_value){
+        if(size_ + count > capacity_) {
+            expand_capacity(size_ + count);
         }
         for(size_type i = 0; i < count; i++){
             data_[i + size_] = char_value;
@@ -376,10 +404,10 @@ public:
     }
 
     template <class InputIt>
-    Basic_string<CharType, Traits, Alloc>& append(InputIt first, InputIt last){
+    Basic_string<CharType, Traits, Alloc, Growth>& append(InputIt first, InputIt last){
         size_t len = last - first;
-        while(size_ + len > capacity_) { 
-            expand_capacity();
+        if(size_ + len > capacity_) {
+            expand_capacity(size_ + len);
         }
 
         size_t i = 0;
@@ -391,35 +419,35 @@ public:
     }
 
     //对字符串的内容赋新的字符值
-    Basic_string<CharType, Traits, Alloc>& assign(const value_type* ptr){
+    Basic_string<CharType, Traits, Alloc, Growth>& assign(const value_type* ptr){
         clear();
         return append(ptr);
     }
 
-    Basic_string<CharType, Traits, Alloc>& assign(const value_type* ptr, size_type count){
+    Basic_string<CharType, Traits, Alloc, Growth>& assign(const value_type* ptr, size_type count){
         clear();
         return append(ptr, count);
     }
 
-    Basic_string<CharType, Traits, Alloc>& assign(const Basic_string<CharType, Traits, Alloc>& str,
+    Basic_string<CharType, Traits, Alloc, Growth>& assign(const Basic_string<CharType, Traits, Alloc, Growth>& str,
     size_type off,
     size_type count){
         clear();
         return append(str.c_str(), off, count);
     }
 
-    Basic_string<CharType, Traits, Alloc>& assign(const Basic_string<CharType, Traits, Alloc>& str){
+    Basic_string<CharType, Traits, Alloc, Growth>& assign(const Basic_string<CharType, Traits, Alloc, Growth>& str){
         clear();
         return append(str.c_str());
     }
 
-    Basic_string<CharType, Traits, Alloc>& assign(size_type count, value_type char_value){
+    Basic_string<CharType, Traits, Alloc, Growth>& assign(size_type count, value_type char_value){
         clear();
         return append(count, char_value);
     }
 
     template <class InIt>
-    Basic_string<CharType, Traits, Alloc>& assign(InIt first, InIt last){
+    Basic_string<CharType, Traits, Alloc, Growth>& assign(InIt first, InIt last){
         clear();
         return append(first, last);
     }
@@ -436,17 +464,22 @@ public:
         return newData;
     }
 
+    // 指向内部字符数组（不保证以 '\0' 结尾）
+    const value_type* data() const noexcept {
+        return data_;
+    }
+
     //与指定字符串进行区分大小写的比较，以确定两个字符串是否相等或按字典顺序一个字符串是否小于另一个
-    int compare(const Basic_string<CharType, Traits, Alloc>& str) const{
+    int compare(const Basic_string<CharType, Traits, Alloc, Growth>& str) const{
         return compare(0, size_, str, 0, str.size());
     }
 
     int compare(size_type position_1, size_type number_1,
-    const Basic_string<CharType, Traits, Alloc>& str) const{
+    const Basic_string<CharType, Traits, Alloc, Growth>& str) const{
         return compare(position_1, number_1, str, 0, str.size());
     }
 
-    int compare(size_type position_1,size_type number_1, const Basic_string<CharType, Traits, Alloc>& str,
+    int compare(size_type position_1,size_type number_1, const Basic_string<CharType, Traits, Alloc, Growth>& str,
     size_type position_2, size_type number_2) const{
         CharType* str_pointer = str.data_;
         size_t str_len = str.size();
@@ -521,7 +554,7 @@ public:
         return true;
     }
 
-    bool ends_with(const Basic_string<CharType, Traits, Alloc>& x) const noexcept{
+    bool ends_with(const Basic_string<CharType, Traits, Alloc, Growth>& x) const noexcept{
         size_t x_len = x.size();
         for(size_t i = 0; i < x_len; i++){
             if(data_[size_ - 1 - i] != x[x_len - 1 - i])
@@ -553,7 +586,7 @@ public:
         return erase(iter, iterator(data_ + size_));
     }
 
-    Basic_string<CharType, Traits, Alloc>& erase(size_type offset = 0, size_type count = npos){
+    Basic_string<CharType, Traits, Alloc, Growth>& erase(size_type offset = 0, size_type count = npos){
         if (offset >= size_) {
             throw std::out_of_range("Basic_string::at: index out of range");
         }
@@ -576,15 +609,12 @@ public:
 
     //向前搜索字符串，搜索与指定字符序列匹配的第一个子字符串
     size_type find(value_type char_value, size_type offset = 0) const{
-        for (size_t i = offset; i < size_; ++i) {
-            if (data_[i] == char_value) {
-                return i;
-            }
-        }
-        return npos;
+        if (offset >= size_) return npos;
+        const CharType* p = Traits::find(data_ + offset, size_ - offset, char_value);
+        return p ? p - data_ : npos;
     }
 
-    // 使用 KMP 算法查找子字符串的 find 函数
+    // 子字符串查找，见 find_impl
     size_t find(const CharType* str, size_t offset = 0) const {
         return find(str, offset, strlen(str));
     }
@@ -593,18 +623,13 @@ public:
         return find_impl(str, offset, count);
     }
 
-    size_type find(const Basic_string<CharType, Traits, Alloc>& str, size_type offset = 0) const{
-        return find(str.c_str(), offset);
+    size_type find(const Basic_string<CharType, Traits, Alloc, Growth>& str, size_type offset = 0) const{
+        return find_impl(str.data_, offset, str.size_);
     }
 
     //在字符串中搜索不属于指定字符串中元素的第一个字符
     size_type find_first_not_of(value_type char_value, size_type offset = 0) const{
-        for (size_t i = offset; i < size_; ++i) {
-            if (data_[i] != char_value) {
-                return i;
-            }
-        }
-        return npos;
+        return find_first_of_base(&char_value, offset, 1, true);
     }
 
     size_type find_first_not_of(const value_type* ptr, size_type offset = 0) const{
@@ -612,35 +637,16 @@ public:
     }
 
     size_type find_first_not_of(const value_type* ptr, size_type offset, size_type count) const{
-        if (offset >= size_) {
-            return npos;
-        }
-        std::unordered_set<CharType> charSet;
-        size_t s_len = 0;
-        while (ptr[s_len] != '\0' && count--) {
-            charSet.insert(ptr[s_len]);
-            ++s_len;
-        }
-        for (size_t i = offset; i < size_; ++i) {
-            if (charSet.find(data_[i]) == charSet.end()) {
-                return i;
-            }
-        }
-        return npos;
+        return find_first_of_base(ptr, offset, count, true);
     }
 
-    size_type find_first_not_of(const Basic_string<CharType, Traits, Alloc>& str, size_type offset = 0) const{
-        return find_first_not_of(str.c_str(), offset);
+    size_type find_first_not_of(const Basic_string<CharType, Traits, Alloc, Growth>& str, size_type offset = 0) const{
+        return find_first_of_base(str.data_, offset, str.size_, true);
     }
 
     //在字符串中搜索与指定字符串中任何元素匹配的第一个字符
     size_type find_first_of(value_type char_value, size_type offset = 0) const{
-        for (size_t i = offset; i < size_; ++i) {
-            if (data_[i] == char_value) {
-                return i;
-            }
-        }
-        return npos;
+        return find(char_value, offset);
     }
 
     size_type find_first_of(const value_type* ptr, size_type offset = 0) const{
@@ -648,36 +654,16 @@ public:
     }
 
     size_type find_first_of(const value_type* ptr, size_type offset, size_type count) const{
-        if (offset >= size_) {
-            return npos;
-        }
-        std::unordered_set<CharType> charSet;
-        size_t s_len = 0;
-        while (ptr[s_len] != '\0' && count--) {
-            charSet.insert(ptr[s_len]);
-            ++s_len;
-        }
-        for (size_t i = offset; i < size_; ++i) {
-            if (charSet.find(data_[i]) != charSet.end()) {
-                return i;
-            }
-        }
-        return npos;
+        return find_first_of_base(ptr, offset, count, false);
     }
 
-    size_type find_first_of(const Basic_string<CharType, Traits, Alloc>& str, size_type offset = 0) const{
-        return find_first_of(str.c_str(), offset);
+    size_type find_first_of(const Basic_string<CharType, Traits, Alloc, Growth>& str, size_type offset = 0) const{
+        return find_first_of_base(str.data_, offset, str.size_, false);
     }
 
     //在字符串中搜索不属于指定字符串中任何元素的最后一个字符
     size_type find_last_not_of(value_type char_value, size_type offset = npos) const{
-        offset = offset == npos ? size_ - 1 : offset;
-        for (size_t i = offset; i > -1; --i) {
-            if (data_[i] == char_value) {
-                return i;
-            }
-        }
-        return npos;
+        return find_last_of_base(&char_value, offset, 1, true);
     }
 
     size_type find_last_not_of(const value_type* ptr, size_type offset = npos) const{
@@ -688,19 +674,13 @@ public:
         return find_last_of_base(ptr, offset, count, true);
     }
 
-    size_type find_last_not_of(const Basic_string<CharType, Traits, Alloc>& str, size_type offset = npos) const{
-        return find_last_not_of(str.c_str(), offset);
+    size_type find_last_not_of(const Basic_string<CharType, Traits, Alloc, Growth>& str, size_type offset = npos) const{
+        return find_last_of_base(str.data_, offset, str.size_, true);
     }
 
     //在字符串中搜索与指定字符串中任何元素匹配的最后一个字符
     size_type find_last_of(value_type char_value, size_type offset = npos) const{
-        offset = offset == npos ? size_ - 1 : offset;
-        for (size_t i = offset; i > -1; --i) {
-            if (data_[i] != char_value) {
-                return i;
-            }
-        }
-        return npos;
+        return rfind(char_value, offset);
     }
 
     size_type find_last_of(const value_type* ptr, size_type offset = npos) const{
@@ -711,24 +691,26 @@ public:
         return find_last_of_base(ptr, offset, count, false);
     }
 
-    size_type find_last_of(const Basic_string<CharType, Traits, Alloc>& str, size_type offset = npos) const{
-        return find_last_of(str.c_str(), offset);
+    size_type find_last_of(const Basic_string<CharType, Traits, Alloc, Growth>& str, size_type offset = npos) const{
+        return find_last_of_base(str.data_, offset, str.size_, false);
     }
 
     //返回用于构造字符串的分配器对象的一个副本
     allocator_type get_allocator() const{
-        return allocator_type();
+        return allocator_;
     }
 
     //将一个、多个或一系列元素插入到指定位置的字符串中
-    Basic_string<CharType, Traits, Alloc>& insert(size_type position, const value_type* ptr){
+    Basic_string<CharType, Traits, Alloc, Growth>& insert(size_type position, const value_type* ptr){
         return insert(position, ptr, strlen(ptr));;
     }
 
     Basic_string& insert(size_t pos, const CharType* str, size_t count) {
         if (pos > size_) return *this;
         
-        reserve(size_ + count);
+        if (size_ + count > capacity_) {
+            expand_capacity(size_ + count);
+        }
         
         // 移动现有元素
         for (size_t i = size_; i > pos; --i) {
@@ -745,24 +727,23 @@ public:
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& insert(size_type position, const Basic_string<CharType, Traits, Alloc>& str){
+    Basic_string<CharType, Traits, Alloc, Growth>& insert(size_type position, const Basic_string<CharType, Traits, Alloc, Growth>& str){
         return insert(position, str.data_, str.size_);
     }
 
-    Basic_string<CharType, Traits, Alloc>& insert(size_type position, const Basic_string<CharType, Traits, Alloc>& str,
+    Basic_string<CharType, Traits, Alloc, Growth>& insert(size_type position, const Basic_string<CharType, Traits, Alloc, Growth>& str,
     size_type offset, size_type count){
         if (offset > str.size_) return *this;
         count = (count == npos) ? str.size_ - offset : std::min(count, str.size_ - offset);
         return insert(position, str.data_ + offset, count);
     }
 
-    Basic_string<CharType, Traits, Alloc>& insert(size_type position, size_type count, value_type char_value){
+    Basic_string<CharType, Traits, Alloc, Growth>& insert(size_type position, size_type count, value_type char_value){
         if (position > size_) return *this;
         size_type required_size = size_ + count;
 
-        // 扩容直到容量足够
-        while (required_size > capacity_) {
-            expand_capacity();
+        if (required_size > capacity_) {
+            expand_capacity(required_size);
         }
 
         // 后移原数据
@@ -816,59 +797,59 @@ public:
     }
 
     //用指定字符或者从其他范围、字符串或 C 字符串复制的字符来替代字符串中指定位置的元素
-    Basic_string<CharType, Traits, Alloc>& replace(size_type position_1, size_type number_1, const value_type* ptr){
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(size_type position_1, size_type number_1, const value_type* ptr){
         erase(position_1, number_1);
         insert(position_1, ptr);
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& replace(size_type position_1, size_type number_1,
-    const Basic_string<CharType, Traits, Alloc>& str){
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(size_type position_1, size_type number_1,
+    const Basic_string<CharType, Traits, Alloc, Growth>& str){
         return replace(position_1, number_1, str, 0, str.size());
     }
 
-    Basic_string<CharType, Traits, Alloc>& replace(size_type position_1, size_type number_1,
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(size_type position_1, size_type number_1,
     const value_type* ptr, size_type number_2){
         erase(position_1, number_1);
         insert(position_1, ptr, 0, number_2);
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& replace(size_type position_1, size_type number_1,
-    const Basic_string<CharType, Traits, Alloc>& str, size_type position_2, size_type number_2){
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(size_type position_1, size_type number_1,
+    const Basic_string<CharType, Traits, Alloc, Growth>& str, size_type position_2, size_type number_2){
         erase(position_1, number_1);
         insert(position_1, str, position_2, number_2);
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& replace(size_type position_1, size_type number_1, 
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(size_type position_1, size_type number_1, 
     size_type count, value_type char_value){
         erase(position_1, number_1);
         insert(position_1, count, char_value);
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& replace(iterator first0, iterator last0, const value_type* ptr){
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(iterator first0, iterator last0, const value_type* ptr){
         erase(first0, last0);
         insert(first0 - iterator(data_), ptr);
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& replace(iterator first0, iterator last0,
-    const Basic_string<CharType, Traits, Alloc>& str){
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(iterator first0, iterator last0,
+    const Basic_string<CharType, Traits, Alloc, Growth>& str){
         erase(first0, last0);
         insert(first0 - iterator(data_), str);
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& replace(iterator first0, iterator last0,
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(iterator first0, iterator last0,
     const value_type* ptr, size_type number_2){
         erase(first0, last0);
         insert(first0 - iterator(data_), ptr, 0, number_2);
         return *this;
     }
 
-    Basic_string<CharType, Traits, Alloc>& replace(iterator first0, iterator last0,
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(iterator first0, iterator last0,
     size_type count, value_type char_value){
         erase(first0, last0);
         insert(first0 - iterator(data_), count, char_value);
@@ -876,7 +857,7 @@ public:
     }
 
     template <class InputIterator>
-    Basic_string<CharType, Traits, Alloc>& replace(iterator first0, iterator last0,
+    Basic_string<CharType, Traits, Alloc, Growth>& replace(iterator first0, iterator last0,
     InputIterator first, InputIterator last){
         erase(first0, last0);
         insert(first0, first, last);
@@ -904,15 +885,7 @@ public:
 
     // 查找字符
     size_type rfind(value_type char_value, size_type offset = npos) const {
-        if (offset == npos) {
-            offset = length();
-        }
-        while(offset >= 0){
-            if(data_[offset] == char_value)
-                return offset;
-            offset--;
-        }
-        return npos;
+        return rfind_impl(&char_value, offset, 1);
     }
 
     // 查找 C 风格字符串
@@ -922,43 +895,26 @@ public:
 
     // 查找 C 风格字符串的前 count 个字符
     size_type rfind(const value_type* ptr, size_type offset, size_type count) const {
-        if (offset == npos || offset > size_ - 1) {
-            offset = length();
-        }
-        if (offset + 1 < count) {
-            return npos;
-        }
-        for (size_type i = offset + 1 - count; i >= 0; --i) {
-            bool found = true;
-            for (size_type j = 0; j < count; ++j) {
-                if (data_[i + j] != ptr[j]) {
-                    found = false;
-                    break;
-                }
-            }
-            if (found) {
-                return i;
-            }
-        }
-        return npos;
+        return rfind_impl(ptr, offset, count);
     }
 
     // 查找另一个 basic_string
-    size_type rfind(const Basic_string<CharType, Traits, Alloc>& str, size_type offset = npos) const {
-        return rfind(str.c_str(), offset, str.size());
+    size_type rfind(const Basic_string<CharType, Traits, Alloc, Growth>& str, size_type offset = npos) const {
+        return rfind_impl(str.data_, offset, str.size_);
     }
 
     //放弃字符串的超出容量
     void shrink_to_fit(){
-        if(size_ < capacity_){
-            pointer new_data = allocator_.allocate(size_);
+        if(!is_local() && size_ < capacity_){
+            size_t new_capacity = size_;
+            pointer new_data = create_storage(new_capacity);
             for(size_t i = 0; i < size_; i++){
                 allocator_.construct(new_data + i, move(data_[i]));
                 allocator_.destroy(data_ + i);
             }
-            allocator_.deallocate(data_, capacity_);
+            dispose_storage();
             data_ = new_data;
-            capacity_ = size_;
+            capacity_ = new_capacity;
         }
     }
 
@@ -980,95 +936,127 @@ public:
     }
 
     //从字符串起始处的指定位置复制最多某个数目的字符的子字符串
-    Basic_string<CharType, Traits, Alloc> substr(size_type offset = 0, size_type count = npos) const{
-        return Basic_string<CharType, Traits, Alloc> (*this, offset, count);
+    Basic_string<CharType, Traits, Alloc, Growth> substr(size_type offset = 0, size_type count = npos) const{
+        return Basic_string<CharType, Traits, Alloc, Growth> (*this, offset, count);
     }
 
 private:
 
-    // KMP实现细节
+    // 单字节字符且使用默认 char_traits 时交给 String_search（SIMD 过滤 / Horspool），
+    // 其余情况用 Traits 逐字符比较
+    static constexpr bool S_byte_search = sizeof(CharType) == 1 && is_same<Traits, char_traits<CharType>>::value;
+
+    // 查找 [pos, size_) 中 pattern 第一次出现的位置
     size_t find_impl(const CharType* pattern, size_t pos, size_t pattern_len) const {
-        if (pattern_len == 0) return pos <= size_ ? pos : npos;
-        
-        Vector<size_t> lps(pattern_len);
-        compute_lps(pattern, pattern_len, lps.data());
-        
-        size_t i = pos, j = 0;
-        while (i < size_) {
-            if (Traits::eq(data_[i], pattern[j])) {
-                ++i; ++j;
-                if (j == pattern_len) return i - j;
-            } else if (j > 0) {
-                j = lps[j-1];
-            } else {
-                ++i;
+        if (pos > size_) return npos;
+        if (pattern_len == 0) return pos;
+
+        if constexpr (S_byte_search) {
+            size_t r = String_search::S_find(reinterpret_cast<const char*>(data_ + pos), size_ - pos,
+                                             reinterpret_cast<const char*>(pattern), pattern_len);
+            return r == String_search::S_npos ? npos : pos + r;
+        }
+        else {
+            const CharType* first = data_ + pos;
+            const CharType* last  = data_ + size_;
+            while (static_cast<size_t>(last - first) >= pattern_len) {
+                first = Traits::find(first, (last - first) - pattern_len + 1, pattern[0]);
+                if (first == nullptr) return npos;
+                if (Traits::compare(first + 1, pattern + 1, pattern_len - 1) == 0) return first - data_;
+                ++first;
             }
+            return npos;
         }
-        return npos;
     }
 
-    void compute_lps(const CharType* pattern, size_t len, size_t* lps) const {
-        size_t prev = 0;
-        lps[0] = 0;
-        
-        for (size_t i = 1; i < len; ) {
-            if (Traits::eq(pattern[i], pattern[prev])) {
-                lps[i++] = ++prev;
-            } else if (prev != 0) {
-                prev = lps[prev-1];
-            } else {
-                lps[i++] = 0;
+    // 查找起点不超过 pos 的最后一次出现位置
+    size_t rfind_impl(const CharType* pattern, size_t pos, size_t pattern_len) const {
+        if (pattern_len > size_) return npos;
+        size_t limit = std::min(size_ - pattern_len, pos);
+        if (pattern_len == 0) return limit;
+
+        if constexpr (S_byte_search) {
+            size_t r = String_search::S_rfind(reinterpret_cast<const char*>(data_), limit + pattern_len,
+                                              reinterpret_cast<const char*>(pattern), pattern_len);
+            return r == String_search::S_npos ? npos : r;
+        }
+        else {
+            for (size_t i = limit + 1; i-- > 0; ) {
+                if (Traits::eq(data_[i], pattern[0]) && Traits::compare(data_ + i, pattern, pattern_len) == 0) {
+                    return i;
+                }
             }
+            return npos;
         }
     }
 
-    //find_last_not_of和find_last_of函数
-    size_type find_last_of_base(const value_type* ptr, size_type offset, size_type count, bool not_or_in) const{
-        if (size_ == 0) return npos;
+    // find_first_of / find_first_not_of：not_or_in 为 true 时查找第一个不属于 [ptr, ptr+count) 的字符
+    size_type find_first_of_base(const value_type* ptr, size_type offset, size_type count, bool not_or_in) const{
+        if (offset >= size_) return npos;
 
-        if (offset >= size_) {
-            offset = size_ - 1;
+        if constexpr (S_byte_search) {
+            Char_class set(reinterpret_cast<const char*>(ptr), count);
+            size_t r = set.M_find_first(reinterpret_cast<const char*>(data_ + offset), size_ - offset, !not_or_in);
+            return r == String_search::S_npos ? npos : offset + r;
         }
-
-        size_t ptr_len = strlen(ptr);
-        std::unordered_set<CharType> charSet;
-
-        size_t ptr_position = 0;
-        while (ptr_position < ptr_len && count-- > 0) {
-            charSet.insert(ptr[ptr_position]);
-            ++ptr_position;
-        }
-        if(not_or_in){
-            //find_last_not_of函数
-            for (long long i = static_cast<long long>(offset); i >= 0; --i) {
-                if (charSet.find(data_[i]) == charSet.end()) {
-                    return static_cast<size_type>(i);
+        else {
+            for (size_t i = offset; i < size_; ++i) {
+                if ((Traits::find(ptr, count, data_[i]) != nullptr) != not_or_in) {
+                    return i;
                 }
             }
+            return npos;
         }
-        else{
-            //find_last_of函数
-            for (long long i = static_cast<long long>(offset); i >= 0; --i) {
-                if (charSet.find(data_[i]) != charSet.end()) {
-                    return static_cast<size_type>(i);
+    }
+
+    //find_last_not_of和find_last_of函数：在 [0, offset] 中从后往前查找
+    size_type find_last_of_base(const value_type* ptr, size_type offset, size_type count, bool not_or_in) const{
+        if (size_ == 0) return npos;
+        size_t n = std::min(offset, size_ - 1) + 1;
+
+        if constexpr (S_byte_search) {
+            Char_class set(reinterpret_cast<const char*>(ptr), count);
+            size_t r = set.M_find_last(reinterpret_cast<const char*>(data_), n, !not_or_in);
+            return r == String_search::S_npos ? npos : r;
+        }
+        else {
+            for (size_t i = n; i-- > 0; ) {
+                if ((Traits::find(ptr, count, data_[i]) != nullptr) != not_or_in) {
+                    return i;
                 }
             }
+            return npos;
         }
-
-        return npos;
     }
-
 };
 
 //重载<<
-template <class CharType, class Traits, class Alloc>
-std::ostream& operator<<(std::ostream& os, const Basic_string<CharType, Traits, Alloc>& str) {
+template <class CharType, class Traits, class Alloc, class Growth>
+std::ostream& operator<<(std::ostream& os, const Basic_string<CharType, Traits, Alloc, Growth>& str) {
     for (size_t i = 0; i < str.size(); ++i) {
         os << str[i];
     }
     return os;
 }
 
+template <class CharType, class Traits, class Alloc, class Growth>
+bool operator==(const Basic_string<CharType, Traits, Alloc, Growth>& x, const Basic_string<CharType, Traits, Alloc, Growth>& y) {
+    return x.size() == y.size() && Traits::compare(x.data(), y.data(), x.size()) == 0;
+}
+
+template <class CharType, class Traits, class Alloc, class Growth>
+bool operator!=(const Basic_string<CharType, Traits, Alloc, Growth>& x, const Basic_string<CharType, Traits, Alloc, Growth>& y) {
+    return !(x == y);
+}
+
+// 哈希支持，供 Unordered_map / Unordered_set 使用
+template <class CharType, class Traits, class Alloc, class Growth>
+struct std::hash<Basic_string<CharType, Traits, Alloc, Growth>> {
+    size_t operator()(const Basic_string<CharType, Traits, Alloc, Growth>& str) const noexcept {
+        return std::hash<std::basic_string_view<CharType, Traits>>{}({str.data(), str.size()});
+    }
+};
+
 
 /// A string of @c char
 using String = Basic_string<char>;
@@ -0,0 +1,1209 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "rb_tree.h"
+#include "allocator.h"
+
+// 节点内有序数组的计数式查找：统计比较成立的元素个数即得到下标。
+// 4/8 字节整数键配合 std::less / std::greater 时整段做 SIMD 比较
+// （AVX2 每次 32 字节，SSE2 每次 16 字节；8 字节键在没有 AVX2 时需要 SSE4.2），
+// 其余情况由 Btree 自己做二分查找
+struct Btree_search{
+    // a[0, n) 中小于 k（Greater 为 true 时：大于 k）的元素个数
+    template<bool Greater, typename T>
+    static size_t S_count(const T* a, size_t n, T k) noexcept {
+        static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), "integral key expected");
+        size_t i = 0, c = 0;
+#if defined(__AVX2__)
+        if constexpr (sizeof(T) == 4) {
+            // 无符号数异或符号位后即可用有符号比较
+            const __m256i bias = _mm256_set1_epi32(std::is_unsigned<T>::value ? INT32_MIN : 0);
+            const __m256i key  = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(k)), bias);
+            for (; i + 8 <= n; i += 8) {
+                __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), bias);
+                __m256i m = Greater ? _mm256_cmpgt_epi32(x, key) : _mm256_cmpgt_epi32(key, x);
+                c += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+            }
+        }
+        else {
+            const __m256i bias = _mm256_set1_epi64x(std::is_unsigned<T>::value ? INT64_MIN : 0);
+            const __m256i key  = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(k)), bias);
+            for (; i + 4 <= n; i += 4) {
+                __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), bias);
+                __m256i m = Greater ? _mm256_cmpgt_epi64(x, key) : _mm256_cmpgt_epi64(key, x);
+                c += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+            }
+        }
+#elif defined(__SSE2__)
+        if constexpr (sizeof(T) == 4) {
+            const __m128i bias = _mm_set1_epi32(std::is_unsigned<T>::value ? INT32_MIN : 0);
+            const __m128i key  = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(k)), bias);
+            for (; i + 4 <= n; i += 4) {
+                __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), bias);
+                __m128i m = Greater ? _mm_cmpgt_epi32(x, key) : _mm_cmpgt_epi32(key, x);
+                c += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(m)));
+            }
+        }
+#if defined(__SSE4_2__)
+        else {
+            const __m128i bias = _mm_set1_epi64x(std::is_unsigned<T>::value ? INT64_MIN : 0);
+            const __m128i key  = _mm_xor_si128(_mm_set1_epi64x(static_cast<int64_t>(k)), bias);
+            for (; i + 2 <= n; i += 2) {
+                __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), bias);
+                __m128i m = Greater ? _mm_cmpgt_epi64(x, key) : _mm_cmpgt_epi64(key, x);
+                c += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(m)));
+            }
+        }
+#endif
+#endif
+        for (; i < n; ++i) {
+            c += Greater ? (k < a[i]) : (a[i] < k);
+        }
+        return c;
+    }
+};
+
+// 节点公共部分
+struct Btree_node_base{
+    Btree_node_base* M_parent;     // 根节点为 nullptr
+    unsigned short   M_position;   // 在父节点孩子数组中的下标
+    unsigned short   M_count;      // 叶子：元素个数；内部节点：分隔键个数（孩子比键多一个）
+    bool             M_leaf;
+};
+
+// 叶子：元素按键有序连续存放，叶子之间用双向链表串起来供迭代器遍历
+template<typename Val, size_t N>
+struct Btree_leaf : public Btree_node_base{
+    Btree_leaf* M_prev;
+    Btree_leaf* M_next;
+    __gnu_cxx::__aligned_membuf<Val> M_values[N];
+
+    Val* M_valptr(size_t i) noexcept {
+        return M_values[i]._M_ptr();
+    }
+
+    const Val* M_valptr(size_t i) const noexcept {
+        return M_values[i]._M_ptr();
+    }
+};
+
+// 内部节点：第 i 个孩子中的键 k 满足 key[i-1] <= k < key[i]
+template<typename Key, size_t N>
+struct Btree_internal : public Btree_node_base{
+    __gnu_cxx::__aligned_membuf<Key> M_keys[N];
+    Btree_node_base* M_children[N + 1];
+
+    Key* M_keyptr(size_t i) noexcept {
+        return M_keys[i]._M_ptr();
+    }
+
+    const Key* M_keyptr(size_t i) const noexcept {
+        return M_keys[i]._M_ptr();
+    }
+};
+
+// extract() 返回的节点：元素存放在叶子数组中，提取时把值移动到单独分配的节点中
+template<typename Val>
+struct Btree_value_node{
+    __gnu_cxx::__aligned_membuf<Val> M_storage;
+
+    Val* M_valptr(){
+        return M_storage._M_ptr();
+    }
+
+    const Val* M_valptr() const {
+        return M_storage._M_ptr();
+    }
+};
+
+// B+ 树迭代器（双向迭代器）：叶子指针加叶内下标，end() 为最右叶子的末尾
+template<typename Val, size_t N, bool IsConst>
+class Btree_iterator{
+    using Leaf = Btree_leaf<Val, N>;
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = Val;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::conditional_t<IsConst, const Val*, Val*>;
+    using reference         = std::conditional_t<IsConst, const Val&, Val&>;
+
+    Btree_iterator() noexcept : M_leaf(nullptr), M_index(0) {}
+
+    Btree_iterator(Leaf* leaf, size_t index) noexcept : M_leaf(leaf), M_index(index) {}
+
+    // 非 const 迭代器到 const 迭代器的转换
+    template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Btree_iterator(const Btree_iterator<Val, N, OtherConst>& other) noexcept
+        : M_leaf(other.M_leaf), M_index(other.M_index) {}
+
+    reference operator*() const noexcept {
+        return *M_leaf->M_valptr(M_index);
+    }
+
+    pointer operator->() const noexcept {
+        return M_leaf->M_valptr(M_index);
+    }
+
+    Btree_iterator& operator++() noexcept {
+        if (++M_index == M_leaf->M_count && M_leaf->M_next) {
+            M_leaf = M_leaf->M_next;
+            M_index = 0;
+        }
+        return *this;
+    }
+
+    Btree_iterator operator++(int) noexcept {
+        Btree_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    Btree_iterator& operator--() noexcept {
+        if (M_index == 0) {
+            M_leaf = M_leaf->M_prev;
+            M_index = M_leaf->M_count;
+        }
+        --M_index;
+        return *this;
+    }
+
+    Btree_iterator operator--(int) noexcept {
+        Btree_iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    Btree_iterator<Val, N, false> M_const_cast() const noexcept {
+        return Btree_iterator<Val, N, false>(M_leaf, M_index);
+    }
+
+    friend bool operator==(const Btree_iterator& x, const Btree_iterator& y) noexcept {
+        return x.M_leaf == y.M_leaf && x.M_index == y.M_index;
+    }
+
+    friend bool operator!=(const Btree_iterator& x, const Btree_iterator& y) noexcept {
+        return !(x == y);
+    }
+
+private:
+    template<typename, size_t, bool>
+    friend class Btree_iterator;
+
+    template<typename, typename, typename, typename, typename>
+    friend class Btree;
+
+    Leaf*  M_leaf;
+    size_t M_index;
+};
+
+// B+ 树（仅支持唯一键），作为 Map / Set 的可选底层实现。
+// 每个节点约 512 字节，存放 16~64 个有序的键，一次缓存缺失可以排除几十个候选，
+// 查找热点在节点内部，整数键用 SIMD 比较整个节点。
+// 与 Rb_tree 不同，元素直接存放在叶子中：插入、删除都会使迭代器和引用失效。
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc = Allocator<Val>>
+class Btree{
+
+    static constexpr size_t S_target_node_size = 512;
+
+    static constexpr size_t S_clamp_slots(size_t n) noexcept {
+        return n < 16 ? 16 : n > 64 ? 64 : n;
+    }
+
+    static constexpr size_t S_leaf_slots     = S_clamp_slots(S_target_node_size / sizeof(Val));
+    static constexpr size_t S_internal_slots = S_clamp_slots(S_target_node_size / (sizeof(Key) + sizeof(void*)));
+    static constexpr size_t S_leaf_min       = S_leaf_slots / 2;
+    static constexpr size_t S_internal_min   = S_internal_slots / 2;
+    static constexpr size_t S_max_height     = 32;
+
+    using Base_ptr = Btree_node_base*;
+    using Leaf     = Btree_leaf<Val, S_leaf_slots>;
+    using Internal = Btree_internal<Key, S_internal_slots>;
+
+    using Val_allocator      = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Val>::other;
+    using Leaf_allocator     = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Leaf>::other;
+    using Internal_allocator = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Internal>::other;
+    using Node_allocator     = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Btree_value_node<Val>>::other;
+    using Alloc_traits       = __gnu_cxx::__alloc_traits<Val_allocator>;
+    using Leaf_traits        = __gnu_cxx::__alloc_traits<Leaf_allocator>;
+    using Internal_traits    = __gnu_cxx::__alloc_traits<Internal_allocator>;
+    using Node_traits        = __gnu_cxx::__alloc_traits<Node_allocator>;
+
+    static constexpr bool S_less_compare    = is_same_v<Compare, std::less<Key>> || is_same_v<Compare, std::less<>>;
+    static constexpr bool S_greater_compare = is_same_v<Compare, std::greater<Key>> || is_same_v<Compare, std::greater<>>;
+    static constexpr bool S_simd_keys       = is_integral_v<Key> && !is_same_v<Key, bool> &&
+                                              (sizeof(Key) == 4 || sizeof(Key) == 8) &&
+                                              (S_less_compare || S_greater_compare);
+
+public:
+    using key_type               = Key;
+    using value_type             = Val;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = size_t;
+    using difference_type        = std::ptrdiff_t;
+    using allocator_type         = Alloc;
+    using iterator               = Btree_iterator<Val, S_leaf_slots, false>;
+    using const_iterator         = Btree_iterator<Val, S_leaf_slots, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using node_type              = Node_handle<Key, Val, Node_allocator>;
+    using insert_return_type     = Node_insert_return<__conditional_t<is_same_v<Key, Val>, const_iterator, iterator>,
+                                                      node_type>;
+
+private:
+    Base_ptr      M_root      = nullptr;
+    Leaf*         M_leftmost  = nullptr;
+    Leaf*         M_rightmost = nullptr;
+    size_t        M_size      = 0;
+    Compare       M_key_compare;
+    Val_allocator M_alloc;
+
+    template<typename, typename, typename, typename, typename>
+    friend class Btree;
+
+    static const Key& S_key(const Val& v) {
+        return KeyOfValue()(v);
+    }
+
+    // 叶子数组中取键，内部节点数组本身就是键
+    template<typename T>
+    static const auto& S_key_at(const T& x) {
+        if constexpr (is_same_v<T, Val>)
+            return KeyOfValue()(x);
+        else
+            return x;
+    }
+
+    static Leaf* S_leaf(Base_ptr x) noexcept {
+        return static_cast<Leaf*>(x);
+    }
+
+    static Internal* S_internal(Base_ptr x) noexcept {
+        return static_cast<Internal*>(x);
+    }
+
+    static void S_set_child(Internal* n, size_t i, Base_ptr c) noexcept {
+        n->M_children[i] = c;
+        c->M_parent = n;
+        c->M_position = static_cast<unsigned short>(i);
+    }
+
+    // 有序数组 a[0, n) 上的 lower_bound（Upper 为 true 时 upper_bound）下标
+    template<bool Upper, typename T, typename Kt>
+    size_t M_bound(const T* a, size_t n, const Kt& k) const {
+        if constexpr (S_simd_keys && is_same_v<T, Key> && is_same_v<Kt, Key>) {
+            if constexpr (S_less_compare)
+                return Upper ? n - Btree_search::S_count<true>(a, n, k) : Btree_search::S_count<false>(a, n, k);
+            else
+                return Upper ? n - Btree_search::S_count<false>(a, n, k) : Btree_search::S_count<true>(a, n, k);
+        }
+        else {
+            // 无分支二分：每轮只根据一次比较调整区间
+            size_t lo = 0, len = n;
+            while (len > 0) {
+                size_t half = len >> 1;
+                bool right = Upper ? !M_key_compare(k, S_key_at(a[lo + half]))
+                                   : M_key_compare(S_key_at(a[lo + half]), k);
+                lo  = right ? lo + half + 1 : lo;
+                len = right ? len - half - 1 : half;
+            }
+            return lo;
+        }
+    }
+
+    // 自根向下找到 k 所在的叶子
+    template<typename Kt>
+    Leaf* M_find_leaf(const Kt& k) const {
+        Base_ptr x = M_root;
+        while (!x->M_leaf) {
+            Internal* n = S_internal(x);
+            x = n->M_children[M_bound<true>(n->M_keyptr(0), n->M_count, k)];
+        }
+        return S_leaf(x);
+    }
+
+    // 叶内下标越过末尾时移到下一片叶子的开头（最右叶子的末尾即 end()）
+    static iterator S_normalize(Leaf* leaf, size_t i) noexcept {
+        if (i == leaf->M_count && leaf->M_next)
+            return iterator(leaf->M_next, 0);
+        return iterator(leaf, i);
+    }
+
+    template<bool Upper, typename Kt>
+    iterator M_bound_iterator(const Kt& k) const {
+        if (M_root == nullptr)
+            return iterator();
+        Leaf* leaf = M_find_leaf(k);
+        return S_normalize(leaf, M_bound<Upper>(leaf->M_valptr(0), leaf->M_count, k));
+    }
+
+    Leaf* M_create_leaf() {
+        Leaf_allocator a(M_alloc);
+        Leaf* p = Leaf_traits::allocate(a, 1);
+        ::new(p) Leaf;
+        p->M_parent = nullptr;
+        p->M_position = 0;
+        p->M_count = 0;
+        p->M_leaf = true;
+        p->M_prev = p->M_next = nullptr;
+        return p;
+    }
+
+    void M_put_leaf(Leaf* p) noexcept {
+        Leaf_allocator a(M_alloc);
+        p->~Leaf();
+        Leaf_traits::deallocate(a, p, 1);
+    }
+
+    Internal* M_create_internal() {
+        Internal_allocator a(M_alloc);
+        Internal* p = Internal_traits::allocate(a, 1);
+        ::new(p) Internal;
+        p->M_parent = nullptr;
+        p->M_position = 0;
+        p->M_count = 0;
+        p->M_leaf = false;
+        return p;
+    }
+
+    void M_put_internal(Internal* p) noexcept {
+        Internal_allocator a(M_alloc);
+        p->~Internal();
+        Internal_traits::deallocate(a, p, 1);
+    }
+
+    // 把 src[0, n) 搬到 dst（移动构造后析构源对象），两段可以重叠
+    void M_move_values(Val* dst, Val* src, size_t n) {
+        if (n == 0 || dst == src)
+            return;
+        if constexpr (is_trivially_copyable_v<Val>) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(Val));
+        }
+        else if (dst < src) {
+            for (size_t j = 0; j < n; ++j) {
+                Alloc_traits::construct(M_alloc, dst + j, std::move(src[j]));
+                Alloc_traits::destroy(M_alloc, src + j);
+            }
+        }
+        else {
+            for (size_t j = n; j-- > 0; ) {
+                Alloc_traits::construct(M_alloc, dst + j, std::move(src[j]));
+                Alloc_traits::destroy(M_alloc, src + j);
+            }
+        }
+    }
+
+    static void S_move_keys(Key* dst, Key* src, size_t n) {
+        if (n == 0 || dst == src)
+            return;
+        if constexpr (is_trivially_copyable_v<Key>) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(Key));
+        }
+        else if (dst < src) {
+            for (size_t j = 0; j < n; ++j) {
+                std::_Construct(dst + j, std::move(src[j]));
+                std::_Destroy(src + j);
+            }
+        }
+        else {
+            for (size_t j = n; j-- > 0; ) {
+                std::_Construct(dst + j, std::move(src[j]));
+                std::_Destroy(src + j);
+            }
+        }
+    }
+
+    // 销毁以 x 为根的子树
+    void M_erase_subtree(Base_ptr x) noexcept {
+        if (x->M_leaf) {
+            Leaf* leaf = S_leaf(x);
+            for (size_t j = 0; j < leaf->M_count; ++j)
+                Alloc_traits::destroy(M_alloc, leaf->M_valptr(j));
+            M_put_leaf(leaf);
+        }
+        else {
+            Internal* n = S_internal(x);
+            for (size_t j = 0; j <= n->M_count; ++j)
+                M_erase_subtree(n->M_children[j]);
+            std::_Destroy(n->M_keyptr(0), n->M_keyptr(0) + n->M_count);
+            M_put_internal(n);
+        }
+    }
+
+    void M_reset() noexcept {
+        M_root = nullptr;
+        M_leftmost = M_rightmost = nullptr;
+        M_size = 0;
+    }
+
+    void M_move_data(Btree& x) noexcept {
+        M_root = x.M_root;
+        M_leftmost = x.M_leftmost;
+        M_rightmost = x.M_rightmost;
+        M_size = x.M_size;
+        x.M_reset();
+    }
+
+    // 在非满的内部节点 n 中把 sep 插到第 pos 个键，right 成为第 pos+1 个孩子
+    void M_insert_into_internal(Internal* n, size_t pos, Key& sep, Base_ptr right) noexcept {
+        S_move_keys(n->M_keyptr(pos + 1), n->M_keyptr(pos), n->M_count - pos);
+        for (size_t j = n->M_count; j > pos; --j)
+            S_set_child(n, j + 1, n->M_children[j]);
+        std::_Construct(n->M_keyptr(pos), std::move(sep));
+        S_set_child(n, pos + 1, right);
+        ++n->M_count;
+    }
+
+    // 删除内部节点 n 的第 k 个键及其右侧的孩子
+    void M_erase_from_internal(Internal* n, size_t k) noexcept {
+        std::_Destroy(n->M_keyptr(k));
+        S_move_keys(n->M_keyptr(k), n->M_keyptr(k + 1), n->M_count - k - 1);
+        for (size_t j = k + 1; j < n->M_count; ++j)
+            S_set_child(n, j, n->M_children[j + 1]);
+        --n->M_count;
+    }
+
+    // 叶子分裂会沿途分裂所有已满的祖先，全部满到根时还要一个新根；
+    // 先把需要的内部节点分配好，之后的结构调整不会再失败
+    size_t M_reserve_internals(Leaf* leaf, Internal** spare) {
+        size_t need = 0;
+        Base_ptr p = leaf->M_parent;
+        for (; p && p->M_count == S_internal_slots; p = p->M_parent)
+            ++need;
+        if (p == nullptr)
+            ++need;
+        size_t got = 0;
+        try {
+            for (; got < need; ++got)
+                spare[got] = M_create_internal();
+        }
+        catch (...) {
+            while (got)
+                M_put_internal(spare[--got]);
+            throw;
+        }
+        return need;
+    }
+
+    // 把分隔键 sep 与 left 新分出的右兄弟 right 挂到父节点上，父节点已满时继续向上分裂。
+    // append 表示沿最右路径顺序追加，此时把满节点偏向左侧分裂，使顺序插入的节点保持全满
+    void M_insert_child(Base_ptr left, Key& sep, Base_ptr right, bool append, Internal** spare) noexcept {
+        while (true) {
+            Internal* p = S_internal(left->M_parent);
+            if (p == nullptr) {
+                // left 是根：树长高一层
+                Internal* root = *spare;
+                std::_Construct(root->M_keyptr(0), std::move(sep));
+                root->M_count = 1;
+                S_set_child(root, 0, left);
+                S_set_child(root, 1, right);
+                M_root = root;
+                return;
+            }
+            size_t pos = left->M_position;
+            if (p->M_count < S_internal_slots) {
+                M_insert_into_internal(p, pos, sep, right);
+                return;
+            }
+            // p 已满：连同 sep 共 S_internal_slots + 1 个键，取中间一个上移，
+            // 其后的键与孩子移到新节点 q，两边都不少于 S_internal_min 个键
+            Internal* q = *spare++;
+            if (pos == S_internal_min) {
+                // sep 本身就是中间的键：直接上移，right 成为 q 的第一个孩子
+                size_t moved = S_internal_slots - pos;
+                S_move_keys(q->M_keyptr(0), p->M_keyptr(pos), moved);
+                S_set_child(q, 0, right);
+                for (size_t j = 1; j <= moved; ++j)
+                    S_set_child(q, j, p->M_children[pos + j]);
+                p->M_count = static_cast<unsigned short>(pos);
+                q->M_count = static_cast<unsigned short>(moved);
+                left = p;
+                right = q;
+                continue;
+            }
+            size_t mid = append && pos == S_internal_slots ? S_internal_slots - 1
+                       : pos < S_internal_min ? S_internal_min - 1 : S_internal_min;
+            size_t moved = S_internal_slots - mid - 1;
+            Key up(std::move(*p->M_keyptr(mid)));
+            std::_Destroy(p->M_keyptr(mid));
+            S_move_keys(q->M_keyptr(0), p->M_keyptr(mid + 1), moved);
+            for (size_t j = 0; j <= moved; ++j)
+                S_set_child(q, j, p->M_children[mid + 1 + j]);
+            p->M_count = static_cast<unsigned short>(mid);
+            q->M_count = static_cast<unsigned short>(moved);
+            if (pos <= mid)
+                M_insert_into_internal(p, pos, sep, right);
+            else
+                M_insert_into_internal(q, pos - mid - 1, sep, right);
+            sep = std::move(up);
+            left = p;
+            right = q;
+        }
+    }
+
+    // 分裂已满的叶子，返回第 i 个插入位置分裂后所在的叶子与下标
+    std::pair<Leaf*, size_t> M_split_leaf(Leaf* leaf, size_t i, const Key& k) {
+        // 在最右叶子末尾追加时新叶子只放新元素，顺序插入得到的叶子都是满的
+        bool append = leaf->M_next == nullptr && i == S_leaf_slots;
+        size_t mid = append ? S_leaf_slots : S_leaf_slots / 2;
+        Key sep(append ? k : S_key(*leaf->M_valptr(mid)));
+        Internal* spare[S_max_height];
+        size_t nspare = M_reserve_internals(leaf, spare);
+        Leaf* right;
+        try {
+            right = M_create_leaf();
+        }
+        catch (...) {
+            while (nspare)
+                M_put_internal(spare[--nspare]);
+            throw;
+        }
+        M_move_values(right->M_valptr(0), leaf->M_valptr(mid), S_leaf_slots - mid);
+        right->M_count = static_cast<unsigned short>(S_leaf_slots - mid);
+        leaf->M_count = static_cast<unsigned short>(mid);
+
+        right->M_prev = leaf;
+        right->M_next = leaf->M_next;
+        if (leaf->M_next)
+            leaf->M_next->M_prev = right;
+        else
+            M_rightmost = right;
+        leaf->M_next = right;
+
+        M_insert_child(leaf, sep, right, append, spare);
+        if (!append && i <= mid)
+            return { leaf, i };
+        return { right, i - mid };
+    }
+
+    // 在叶子 leaf 的第 i 个位置构造新元素（k 为其键），叶子已满时先分裂
+    template<typename Arg>
+    iterator M_insert_at(Leaf* leaf, size_t i, const Key& k, Arg&& v) {
+        if (leaf->M_count == S_leaf_slots) {
+            std::pair<Leaf*, size_t> pos = M_split_leaf(leaf, i, k);
+            leaf = pos.first;
+            i = pos.second;
+        }
+        M_move_values(leaf->M_valptr(i + 1), leaf->M_valptr(i), leaf->M_count - i);
+        try {
+            Alloc_traits::construct(M_alloc, leaf->M_valptr(i), std::forward<Arg>(v));
+        }
+        catch (...) {
+            M_move_values(leaf->M_valptr(i), leaf->M_valptr(i + 1), leaf->M_count - i);
+            throw;
+        }
+        ++leaf->M_count;
+        ++M_size;
+        return iterator(leaf, i);
+    }
+
+    // 空树先建立一片空叶子作为根
+    Leaf* M_rightmost_leaf() {
+        if (M_root == nullptr) {
+            Leaf* leaf = M_create_leaf();
+            M_root = M_leftmost = M_rightmost = leaf;
+        }
+        return M_rightmost;
+    }
+
+    // 键 k 的插入位置；second 为 false 表示键已存在，first 即该元素
+    std::pair<iterator, bool> M_get_insert_unique_pos(const Key& k) {
+        if (M_root == nullptr)
+            return { iterator(M_rightmost_leaf(), 0), true };
+        Leaf* leaf = M_find_leaf(k);
+        size_t i = M_bound<false>(leaf->M_valptr(0), leaf->M_count, k);
+        if (i < leaf->M_count && !M_key_compare(k, S_key(*leaf->M_valptr(i))))
+            return { iterator(leaf, i), false };
+        return { iterator(leaf, i), true };
+    }
+
+    // 提示位置 pos 的前后邻居正好夹住 k 时可以直接插入，不必从根查找
+    bool M_hint_fits(const_iterator pos, const Key& k) const {
+        Leaf* leaf = pos.M_leaf;
+        size_t i = pos.M_index;
+        if (leaf == nullptr)
+            return false;
+        bool after_prev  = i > 0 ? M_key_compare(S_key(*leaf->M_valptr(i - 1)), k) : leaf->M_prev == nullptr;
+        bool before_next = i < leaf->M_count ? M_key_compare(k, S_key(*leaf->M_valptr(i))) : leaf->M_next == nullptr;
+        return after_prev && before_next;
+    }
+
+    // 删除叶子中的一个元素后修复下溢：与兄弟合并或向兄弟借一个元素，返回被删元素的下一个位置
+    iterator M_rebalance_leaf(Leaf* leaf, size_t i) {
+        if (leaf == M_root) {
+            if (leaf->M_count == 0) {
+                M_put_leaf(leaf);
+                M_reset();
+                return end();
+            }
+            return S_normalize(leaf, i);
+        }
+        if (leaf->M_count >= S_leaf_min)
+            return S_normalize(leaf, i);
+
+        Internal* p = S_internal(leaf->M_parent);
+        size_t pos = leaf->M_position;
+        if (pos > 0) {
+            Leaf* left = S_leaf(p->M_children[pos - 1]);
+            if (left->M_count + leaf->M_count <= S_leaf_slots) {
+                i += left->M_count;
+                M_merge_leaves(left, leaf);
+                M_rebalance_internal(p);
+                return S_normalize(left, i);
+            }
+            M_move_values(leaf->M_valptr(1), leaf->M_valptr(0), leaf->M_count);
+            M_move_values(leaf->M_valptr(0), left->M_valptr(left->M_count - 1), 1);
+            --left->M_count;
+            ++leaf->M_count;
+            *p->M_keyptr(pos - 1) = S_key(*leaf->M_valptr(0));
+            return S_normalize(leaf, i + 1);
+        }
+        Leaf* right = S_leaf(p->M_children[1]);
+        if (leaf->M_count + right->M_count <= S_leaf_slots) {
+            M_merge_leaves(leaf, right);
+            M_rebalance_internal(p);
+            return S_normalize(leaf, i);
+        }
+        M_move_values(leaf->M_valptr(leaf->M_count), right->M_valptr(0), 1);
+        M_move_values(right->M_valptr(0), right->M_valptr(1), right->M_count - 1);
+        --right->M_count;
+        ++leaf->M_count;
+        *p->M_keyptr(0) = S_key(*right->M_valptr(0));
+        return S_normalize(leaf, i);
+    }
+
+    // right 的元素全部并入左兄弟 left，right 从链表和父节点中摘除
+    void M_merge_leaves(Leaf* left, Leaf* right) noexcept {
+        M_move_values(left->M_valptr(left->M_count), right->M_valptr(0), right->M_count);
+        left->M_count += right->M_count;
+        left->M_next = right->M_next;
+        if (right->M_next)
+            right->M_next->M_prev = left;
+        else
+            M_rightmost = left;
+        M_erase_from_internal(S_internal(left->M_parent), left->M_position);
+        M_put_leaf(right);
+    }
+
+    // 内部节点下溢的修复，可能一路合并到根；根只剩一个孩子时树降低一层
+    void M_rebalance_internal(Internal* n) {
+        while (true) {
+            if (n == M_root) {
+                if (n->M_count == 0) {
+                    Base_ptr child = n->M_children[0];
+                    child->M_parent = nullptr;
+                    child->M_position = 0;
+                    M_root = child;
+                    M_put_internal(n);
+                }
+                return;
+            }
+            if (n->M_count >= S_internal_min)
+                return;
+
+            Internal* p = S_internal(n->M_parent);
+            size_t pos = n->M_position;
+            if (pos > 0) {
+                Internal* left = S_internal(p->M_children[pos - 1]);
+                if (size_t(left->M_count) + n->M_count + 1 <= S_internal_slots) {
+                    M_merge_internals(left, n);
+                    n = p;
+                    continue;
+                }
+                // 父节点的分隔键下移到 n 的最前面，左兄弟的最后一个键上移
+                S_move_keys(n->M_keyptr(1), n->M_keyptr(0), n->M_count);
+                for (size_t j = n->M_count + 1; j > 0; --j)
+                    S_set_child(n, j, n->M_children[j - 1]);
+                std::_Construct(n->M_keyptr(0), std::move(*p->M_keyptr(pos - 1)));
+                *p->M_keyptr(pos - 1) = std::move(*left->M_keyptr(left->M_count - 1));
+                std::_Destroy(left->M_keyptr(left->M_count - 1));
+                S_set_child(n, 0, left->M_children[left->M_count]);
+                --left->M_count;
+                ++n->M_count;
+                return;
+            }
+            Internal* right = S_internal(p->M_children[1]);
+            if (size_t(n->M_count) + right->M_count + 1 <= S_internal_slots) {
+                M_merge_internals(n, right);
+                n = p;
+                continue;
+            }
+            // 父节点的分隔键下移到 n 的末尾，右兄弟的第一个键上移
+            std::_Construct(n->M_keyptr(n->M_count), std::move(*p->M_keyptr(0)));
+            *p->M_keyptr(0) = std::move(*right->M_keyptr(0));
+            S_set_child(n, n->M_count + 1, right->M_children[0]);
+            ++n->M_count;
+            std::_Destroy(right->M_keyptr(0));
+            S_move_keys(right->M_keyptr(0), right->M_keyptr(1), right->M_count - 1);
+            for (size_t j = 0; j < right->M_count; ++j)
+                S_set_child(right, j, right->M_children[j + 1]);
+            --right->M_count;
+            return;
+        }
+    }
+
+    // right 与其左兄弟 left 合并，两者之间的分隔键一并下移
+    void M_merge_internals(Internal* left, Internal* right) noexcept {
+        Internal* p = S_internal(left->M_parent);
+        size_t k = left->M_position;
+        std::_Construct(left->M_keyptr(left->M_count), std::move(*p->M_keyptr(k)));
+        S_move_keys(left->M_keyptr(left->M_count + 1), right->M_keyptr(0), right->M_count);
+        for (size_t j = 0; j <= right->M_count; ++j)
+            S_set_child(left, left->M_count + 1 + j, right->M_children[j]);
+        left->M_count += right->M_count + 1;
+        M_erase_from_internal(p, k);
+        M_put_internal(right);
+    }
+
+    iterator M_erase_at(Leaf* leaf, size_t i) {
+        Alloc_traits::destroy(M_alloc, leaf->M_valptr(i));
+        M_move_values(leaf->M_valptr(i), leaf->M_valptr(i + 1), leaf->M_count - i - 1);
+        --leaf->M_count;
+        --M_size;
+        return M_rebalance_leaf(leaf, i);
+    }
+
+    // 叶内下标到达末尾说明键不存在：之后的叶子中的键都不小于分隔键，而分隔键大于 k
+    template<typename Kt>
+    const_iterator M_find(const Kt& k) const {
+        if (M_root == nullptr)
+            return end();
+        Leaf* leaf = M_find_leaf(k);
+        size_t i = M_bound<false>(leaf->M_valptr(0), leaf->M_count, k);
+        if (i == leaf->M_count || M_key_compare(k, S_key(*leaf->M_valptr(i))))
+            return end();
+        return const_iterator(leaf, i);
+    }
+
+    // 按序追加另一棵树的全部元素，走最右叶子的快速路径
+    template<typename Iterator>
+    void M_append_range(Iterator first, Iterator last) {
+        try {
+            for (; first != last; ++first) {
+                Leaf* leaf = M_rightmost_leaf();
+                M_insert_at(leaf, leaf->M_count, S_key(*first), *first);
+            }
+        }
+        catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+public:
+    Btree() = default;
+
+    Btree(const Compare& comp, const allocator_type& a = allocator_type()) : M_key_compare(comp), M_alloc(a) {}
+
+    Btree(const allocator_type& a) : M_key_compare(), M_alloc(a) {}
+
+    Btree(const Btree& x)
+        : M_key_compare(x.M_key_compare), M_alloc(Alloc_traits::_S_select_on_copy(x.M_alloc)) {
+        M_append_range(x.begin(), x.end());
+    }
+
+    Btree(const Btree& x, const allocator_type& a) : M_key_compare(x.M_key_compare), M_alloc(a) {
+        M_append_range(x.begin(), x.end());
+    }
+
+    Btree(Btree&& x) noexcept : M_key_compare(x.M_key_compare), M_alloc(std::move(x.M_alloc)) {
+        M_move_data(x);
+    }
+
+    Btree(Btree&& x, const allocator_type& a) : M_key_compare(x.M_key_compare), M_alloc(a) {
+        if (Alloc_traits::_S_always_equal() || M_alloc == x.M_alloc) {
+            M_move_data(x);
+        }
+        else {
+            M_append_range(std::make_move_iterator(x.begin()), std::make_move_iterator(x.end()));
+            x.clear();
+        }
+    }
+
+    ~Btree() {
+        clear();
+    }
+
+    Btree& operator=(const Btree& x) {
+        if (this != std::__addressof(x)) {
+            clear();
+            M_key_compare = x.M_key_compare;
+            if (Alloc_traits::_S_propagate_on_copy_assign())
+                std::__alloc_on_copy(M_alloc, x.M_alloc);
+            M_append_range(x.begin(), x.end());
+        }
+        return *this;
+    }
+
+    Btree& operator=(Btree&& x) noexcept(Alloc_traits::_S_nothrow_move()) {
+        if (this == std::__addressof(x))
+            return *this;
+        clear();
+        M_key_compare = x.M_key_compare;
+        if (Alloc_traits::_S_propagate_on_move_assign() || Alloc_traits::_S_always_equal() || M_alloc == x.M_alloc) {
+            std::__alloc_on_move(M_alloc, x.M_alloc);
+            M_move_data(x);
+        }
+        else {
+            // 分配器不相等时只能逐个移动元素
+            M_append_range(std::make_move_iterator(x.begin()), std::make_move_iterator(x.end()));
+            x.clear();
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(M_alloc);
+    }
+
+    Compare key_comp() const {
+        return M_key_compare;
+    }
+
+    iterator begin() noexcept {
+        return iterator(M_leftmost, 0);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(M_leftmost, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(M_rightmost, M_rightmost ? M_rightmost->M_count : 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(M_rightmost, M_rightmost ? M_rightmost->M_count : 0);
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    bool empty() const noexcept {
+        return M_size == 0;
+    }
+
+    size_type size() const noexcept {
+        return M_size;
+    }
+
+    size_type max_size() const noexcept {
+        return Alloc_traits::max_size(M_alloc);
+    }
+
+    void clear() noexcept {
+        if (M_root)
+            M_erase_subtree(M_root);
+        M_reset();
+    }
+
+    void swap(Btree& x) noexcept(__is_nothrow_swappable<Compare>::value) {
+        using std::swap;
+        swap(M_root, x.M_root);
+        swap(M_leftmost, x.M_leftmost);
+        swap(M_rightmost, x.M_rightmost);
+        swap(M_size, x.M_size);
+        swap(M_key_compare, x.M_key_compare);
+        Alloc_traits::_S_on_swap(M_alloc, x.M_alloc);
+    }
+
+    // 唯一插入，Arg 为 value_type
+    template<typename Arg>
+    std::pair<iterator, bool> _M_insert_unique(Arg&& v) {
+        const Key& k = S_key(v);
+        std::pair<iterator, bool> res = M_get_insert_unique_pos(k);
+        if (res.second)
+            res.first = M_insert_at(res.first.M_leaf, res.first.M_index, k, std::forward<Arg>(v));
+        return res;
+    }
+
+    // 带提示的唯一插入：提示不合适时退化为普通插入
+    template<typename Arg>
+    iterator _M_insert_unique_(const_iterator pos, Arg&& v) {
+        const Key& k = S_key(v);
+        if (M_hint_fits(pos, k))
+            return M_insert_at(pos.M_leaf, pos.M_index, k, std::forward<Arg>(v));
+        return _M_insert_unique(std::forward<Arg>(v)).first;
+    }
+
+    // 原地构造唯一插入：先构造出值才能取得键
+    template<typename... Args>
+    std::pair<iterator, bool> _M_emplace_unique(Args&&... args) {
+        value_type tmp(std::forward<Args>(args)...);
+        return _M_insert_unique(std::move(tmp));
+    }
+
+    template<typename... Args>
+    iterator _M_emplace_hint_unique(const_iterator pos, Args&&... args) {
+        value_type tmp(std::forward<Args>(args)...);
+        return _M_insert_unique_(pos, std::move(tmp));
+    }
+
+    // 以 end() 为提示逐个插入：有序输入每次都落在最右叶子末尾，不必从根查找
+    template<typename InputIterator>
+    void M_insert_range_unique(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            if constexpr (is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(*first)>>, value_type>)
+                _M_insert_unique_(end(), *first);
+            else
+                _M_emplace_hint_unique(end(), *first);
+        }
+    }
+
+    template<typename InputIterator>
+    void M_insert_range_sorted_unique(InputIterator first, InputIterator last) {
+        M_insert_range_unique(first, last);
+    }
+
+    template<typename Iterator>
+    void M_assign_unique(Iterator first, Iterator last) {
+        clear();
+        M_insert_range_unique(first, last);
+    }
+
+    iterator erase(const_iterator position) {
+        __glibcxx_assert(position != end());
+        return M_erase_at(position.M_leaf, position.M_index);
+    }
+
+    // 删除会移动元素，last 可能失效，因此先数出个数再逐个删除
+    iterator erase(const_iterator first, const_iterator last) {
+        if (first == begin() && last == end()) {
+            clear();
+            return end();
+        }
+        size_type n = std::distance(first, last);
+        iterator it = first.M_const_cast();
+        while (n--)
+            it = M_erase_at(it.M_leaf, it.M_index);
+        return it;
+    }
+
+    size_type erase(const key_type& k) {
+        iterator it = find(k);
+        if (it == end())
+            return 0;
+        M_erase_at(it.M_leaf, it.M_index);
+        return 1;
+    }
+
+    iterator find(const key_type& k) {
+        return M_find(k).M_const_cast();
+    }
+
+    const_iterator find(const key_type& k) const {
+        return M_find(k);
+    }
+
+    size_type count(const key_type& k) const {
+        return find(k) == end() ? 0 : 1;
+    }
+
+    iterator lower_bound(const key_type& k) {
+        return M_bound_iterator<false>(k);
+    }
+
+    const_iterator lower_bound(const key_type& k) const {
+        return M_bound_iterator<false>(k);
+    }
+
+    iterator upper_bound(const key_type& k) {
+        return M_bound_iterator<true>(k);
+    }
+
+    const_iterator upper_bound(const key_type& k) const {
+        return M_bound_iterator<true>(k);
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& k) {
+        iterator it = lower_bound(k);
+        if (it == end() || M_key_compare(k, S_key(*it)))
+            return { it, it };
+        iterator next = it;
+        return { it, ++next };
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+        const_iterator it = lower_bound(k);
+        if (it == end() || M_key_compare(k, S_key(*it)))
+            return { it, it };
+        const_iterator next = it;
+        return { it, ++next };
+    }
+
+    // 以下是透明查找相关函数，允许使用不同类型的键进行查找
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    iterator M_find_tr(const Kt& k) {
+        return M_find(k).M_const_cast();
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    const_iterator M_find_tr(const Kt& k) const {
+        return M_find(k);
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    size_type M_count_tr(const Kt& k) const {
+        auto p = M_equal_range_tr(k);
+        return std::distance(p.first, p.second);
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    iterator M_lower_bound_tr(const Kt& k) {
+        return M_bound_iterator<false>(k);
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    const_iterator M_lower_bound_tr(const Kt& k) const {
+        return M_bound_iterator<false>(k);
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    iterator M_upper_bound_tr(const Kt& k) {
+        return M_bound_iterator<true>(k);
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    const_iterator M_upper_bound_tr(const Kt& k) const {
+        return M_bound_iterator<true>(k);
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    std::pair<iterator, iterator> M_equal_range_tr(const Kt& k) {
+        return { M_bound_iterator<false>(k), M_bound_iterator<true>(k) };
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    std::pair<const_iterator, const_iterator> M_equal_range_tr(const Kt& k) const {
+        return { M_bound_iterator<false>(k), M_bound_iterator<true>(k) };
+    }
+
+    // 提取一个节点：值被移动到新分配的节点中，叶子中的位置随即删除
+    node_type extract(const_iterator pos) {
+        Node_allocator node_alloc(M_alloc);
+        Btree_value_node<Val>* node = Node_traits::allocate(node_alloc, 1);
+        try {
+            ::new(node) Btree_value_node<Val>;
+            Alloc_traits::construct(M_alloc, node->M_valptr(), std::move(*pos.M_const_cast()));
+        }
+        catch (...) {
+            node->~Btree_value_node<Val>();
+            Node_traits::deallocate(node_alloc, node, 1);
+            throw;
+        }
+        M_erase_at(pos.M_leaf, pos.M_index);
+        return node_type(node, node_alloc);
+    }
+
+    node_type extract(const key_type& k) {
+        node_type nh;
+        const_iterator pos = find(k);
+        if (pos != end())
+            nh = extract(pos);
+        return nh;
+    }
+
+    // 重新插入提取的节点，成功时节点被释放
+    insert_return_type M_reinsert_node_unique(node_type&& nh) {
+        insert_return_type ret;
+        if (nh.empty()) {
+            ret.position = end();
+            return ret;
+        }
+        const Key& k = S_key(nh.value());
+        std::pair<iterator, bool> res = M_get_insert_unique_pos(k);
+        if (res.second) {
+            ret.position = M_insert_at(res.first.M_leaf, res.first.M_index, k, std::move(nh.value()));
+            nh._M_reset();
+            ret.inserted = true;
+        }
+        else {
+            ret.node = std::move(nh);
+            ret.position = res.first;
+            ret.inserted = false;
+        }
+        return ret;
+    }
+
+    iterator M_reinsert_node_hint_unique(const_iterator hint, node_type&& nh) {
+        if (nh.empty())
+            return end();
+        const Key& k = S_key(nh.value());
+        if (M_hint_fits(hint, k)) {
+            iterator ret = M_insert_at(hint.M_leaf, hint.M_index, k, std::move(nh.value()));
+            nh._M_reset();
+            return ret;
+        }
+        return M_reinsert_node_unique(std::move(nh)).position;
+    }
+
+    // 从另一棵有序树（Btree 或 Rb_tree）合并：本树中不存在的键被移动过来并从源树删除
+    template<typename Tree>
+    void M_merge_unique(Tree& src) {
+        if (static_cast<void*>(this) == static_cast<void*>(&src))
+            return;
+        for (auto i = src.begin(); i != src.end(); ) {
+            const Key& k = S_key(*i);
+            std::pair<iterator, bool> res = M_get_insert_unique_pos(k);
+            if (res.second) {
+                M_insert_at(res.first.M_leaf, res.first.M_index, k, std::move(*i));
+                i = src.erase(i);
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    friend bool operator==(const Btree& x, const Btree& y) {
+        return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+    }
+
+    friend bool operator<(const Btree& x, const Btree& y) {
+        return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    }
+};
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+inline void swap(Btree<Key, Val, KeyOfValue, Compare, Alloc>& x, Btree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+    x.swap(y);
+}
+
+// Map / Set 的 Tree 参数：以 B+ 树作为底层实现
+struct Btree_policy{
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+    using Rep = Btree<Key, Val, KeyOfValue, Compare, Alloc>;
+};
+
+#endif // BTREE_H
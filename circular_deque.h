@@ -0,0 +1,739 @@
+#ifndef CIRCULAR_DEQUE_H
+#define CIRCULAR_DEQUE_H
+
+#include "allocator.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T, typename Alloc = Allocator<T>>
+class Circular_deque;
+
+// 环形缓冲区的迭代器：记录缓冲区、掩码、头部下标和逻辑位置，解引用时按掩码取模
+template <typename T, bool IsConst>
+class Circular_deque_iterator {
+private:
+    using Buffer = std::conditional_t<IsConst, const T*, T*>;
+
+    Buffer      data;  // 缓冲区
+    size_t      mask;  // 容量 - 1
+    size_t      head;  // 第一个元素的物理下标
+    std::ptrdiff_t pos; // 逻辑下标
+
+    template <typename U, bool OtherConst>
+    friend class Circular_deque_iterator;
+
+    template <typename U, typename A>
+    friend class Circular_deque;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::conditional_t<IsConst, const T*, T*>;
+    using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+    Circular_deque_iterator() : data(nullptr), mask(0), head(0), pos(0) {}
+
+    Circular_deque_iterator(Buffer d, size_t m, size_t h, difference_type p) : data(d), mask(m), head(h), pos(p) {}
+
+    // 非 const 迭代器转换为 const 迭代器
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Circular_deque_iterator(const Circular_deque_iterator<T, OtherConst>& other)
+        : data(other.data), mask(other.mask), head(other.head), pos(other.pos) {}
+
+    reference operator*() const {
+        return data[(head + pos) & mask];
+    }
+
+    pointer operator->() const {
+        return &**this;
+    }
+
+    reference operator[](difference_type n) const {
+        return data[(head + pos + n) & mask];
+    }
+
+    Circular_deque_iterator& operator++() {
+        ++pos;
+        return *this;
+    }
+
+    Circular_deque_iterator operator++(int) {
+        Circular_deque_iterator temp = *this;
+        ++pos;
+        return temp;
+    }
+
+    Circular_deque_iterator& operator--() {
+        --pos;
+        return *this;
+    }
+
+    Circular_deque_iterator operator--(int) {
+        Circular_deque_iterator temp = *this;
+        --pos;
+        return temp;
+    }
+
+    Circular_deque_iterator& operator+=(difference_type n) {
+        pos += n;
+        return *this;
+    }
+
+    Circular_deque_iterator& operator-=(difference_type n) {
+        pos -= n;
+        return *this;
+    }
+
+    Circular_deque_iterator operator+(difference_type n) const {
+        Circular_deque_iterator temp = *this;
+        return temp += n;
+    }
+
+    friend Circular_deque_iterator operator+(difference_type n, const Circular_deque_iterator& it) {
+        return it + n;
+    }
+
+    Circular_deque_iterator operator-(difference_type n) const {
+        Circular_deque_iterator temp = *this;
+        return temp -= n;
+    }
+
+    difference_type operator-(const Circular_deque_iterator& other) const {
+        return pos - other.pos;
+    }
+
+    bool operator==(const Circular_deque_iterator& other) const {
+        return pos == other.pos;
+    }
+
+    bool operator!=(const Circular_deque_iterator& other) const {
+        return pos != other.pos;
+    }
+
+    bool operator<(const Circular_deque_iterator& other) const {
+        return pos < other.pos;
+    }
+
+    bool operator>(const Circular_deque_iterator& other) const {
+        return other.pos < pos;
+    }
+
+    bool operator<=(const Circular_deque_iterator& other) const {
+        return !(other.pos < pos);
+    }
+
+    bool operator>=(const Circular_deque_iterator& other) const {
+        return !(pos < other.pos);
+    }
+};
+
+// 环形缓冲区实现的双端队列，接口与 Deque 一致，可作为 Queue / Stack 的底层容器：
+// Queue<T, Circular_deque<T>>。
+// 元素放在一整块容量为 2 的幂的缓冲区里，下标用掩码回绕，两端 push/pop 都是 O(1)，
+// 没有 Deque 的块指针数组，也不按块分配。容量用满时翻倍并把元素搬到新缓冲区（迭代器失效）；
+// 有界队列可以先 reserve 到上限，之后用 full() 判断是否还能入队，运行期间不再分配内存
+template <typename T, typename Alloc>
+class Circular_deque {
+public:
+    using iterator               = Circular_deque_iterator<T, false>;
+    using const_iterator         = Circular_deque_iterator<T, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type         = Alloc;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using difference_type        = std::ptrdiff_t;
+    using value_type             = T;
+    using size_type              = size_t;
+
+private:
+    // 第一次分配时的最小容量
+    static constexpr size_t S_min_capacity = 8;
+
+    T* data_ = nullptr;
+    size_t capacity_ = 0;   // 0 或 2 的幂
+    size_t head_ = 0;       // 第一个元素的物理下标
+    size_t size_ = 0;
+    Alloc allocator_;
+
+    size_t mask() const noexcept {
+        return capacity_ - 1;
+    }
+
+    // 逻辑下标 i 处元素的地址
+    T* slot(size_t i) const noexcept {
+        return data_ + ((head_ + i) & mask());
+    }
+
+    // 不小于 n 的最小 2 的幂
+    static size_t S_round_up(size_t n) noexcept {
+        size_t capacity = S_min_capacity;
+        while (capacity < n) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    // 把逻辑区间 [from, from + n) 搬到未初始化的连续内存 dst，之后原位置视为已销毁。
+    // 缓冲区回绕时分两段处理，可平凡重定位的类型整段 memcpy
+    void relocate_out(T* dst, size_t from, size_t n) {
+        size_t first = (head_ + from) & mask();
+        size_t first_len = std::min(n, capacity_ - first);
+        relocate_range(dst, data_ + first, first_len);
+        relocate_range(dst + first_len, data_, n - first_len);
+    }
+
+    void relocate_range(T* dst, T* src, size_t n) {
+        if constexpr (Is_trivially_relocatable_v<T>) {
+            if (n) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                allocator_.construct(dst + i, std::move(src[i]));
+                allocator_.destroy(src + i);
+            }
+        }
+    }
+
+    // 换成容量为 new_capacity 的缓冲区（不小于 size_），元素从物理下标 0 开始重新排列
+    void reallocate(size_t new_capacity) {
+        T* new_data = new_capacity ? allocator_.allocate(new_capacity) : nullptr;
+        if (size_) {
+            relocate_out(new_data, 0, size_);
+        }
+        if (data_) {
+            allocator_.deallocate(data_, capacity_);
+        }
+        data_ = new_data;
+        capacity_ = new_capacity;
+        head_ = 0;
+    }
+
+    // 缓冲区已满时在逻辑位置 offset（0 或 size_）插入：先在新缓冲区构造新元素，
+    // 再把旧元素搬过去，参数引用旧缓冲区中的元素时也安全，构造抛异常时原内容不变
+    template <typename... Args>
+    void grow_and_emplace(size_t offset, Args&&... args) {
+        size_t new_capacity = capacity_ ? capacity_ * 2 : S_min_capacity;
+        T* new_data = allocator_.allocate(new_capacity);
+        try {
+            allocator_.construct(new_data + offset, std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(new_data, new_capacity);
+            throw;
+        }
+        if (size_) {
+            relocate_out(new_data, 0, offset);
+            relocate_out(new_data + offset + 1, offset, size_ - offset);
+        }
+        if (data_) {
+            allocator_.deallocate(data_, capacity_);
+        }
+        data_ = new_data;
+        capacity_ = new_capacity;
+        head_ = 0;
+        ++size_;
+    }
+
+    void destroy_all() noexcept {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < size_; ++i) {
+                allocator_.destroy(slot(i));
+            }
+        }
+    }
+
+public:
+    // 默认构造函数，不分配内存
+    Circular_deque() = default;
+
+    // 带分配器的构造函数
+    explicit Circular_deque(const Alloc& Al) : allocator_(Al) {}
+
+    // 带元素数量的构造函数
+    explicit Circular_deque(size_type Count, const Alloc& Al = Alloc()) : allocator_(Al) {
+        resize(Count);
+    }
+
+    // 带元素数量和初始值的构造函数
+    Circular_deque(size_type Count, const T& Val, const Alloc& Al = Alloc()) : allocator_(Al) {
+        assign(Count, Val);
+    }
+
+    // 迭代器范围构造函数
+    template <class InputIterator,
+              typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+              typename std::iterator_traits<InputIterator>::iterator_category>>>
+    Circular_deque(InputIterator First, InputIterator Last, const Alloc& Al = Alloc()) : allocator_(Al) {
+        assign(First, Last);
+    }
+
+    // 初始化列表构造函数
+    Circular_deque(std::initializer_list<T> IList, const Alloc& Al = Alloc()) : allocator_(Al) {
+        assign(IList.begin(), IList.end());
+    }
+
+    // 拷贝构造函数：容量只取到能放下全部元素的 2 的幂
+    Circular_deque(const Circular_deque& Right) : allocator_(Right.allocator_) {
+        assign(Right.begin(), Right.end());
+    }
+
+    // 带分配器的拷贝构造函数
+    Circular_deque(const Circular_deque& Right, const Alloc& Al) : allocator_(Al) {
+        assign(Right.begin(), Right.end());
+    }
+
+    // 移动构造函数：直接接管缓冲区
+    Circular_deque(Circular_deque&& Right) noexcept
+        : data_(Right.data_), capacity_(Right.capacity_), head_(Right.head_), size_(Right.size_),
+          allocator_(std::move(Right.allocator_)) {
+        Right.data_ = nullptr;
+        Right.capacity_ = Right.head_ = Right.size_ = 0;
+    }
+
+    // 带分配器的移动构造函数
+    Circular_deque(Circular_deque&& Right, const Alloc& Al) : allocator_(Al) {
+        if (Al == Right.allocator_) {
+            swap(Right);
+        } else {
+            assign(std::make_move_iterator(Right.begin()), std::make_move_iterator(Right.end()));
+        }
+    }
+
+    ~Circular_deque() {
+        destroy_all();
+        if (data_) {
+            allocator_.deallocate(data_, capacity_);
+        }
+    }
+
+    Circular_deque& operator=(const Circular_deque& Right) {
+        if (this != &Right) {
+            assign(Right.begin(), Right.end());
+        }
+        return *this;
+    }
+
+    Circular_deque& operator=(Circular_deque&& Right) noexcept {
+        if (this != &Right) {
+            clear();
+            if (data_) {
+                allocator_.deallocate(data_, capacity_);
+                data_ = nullptr;
+                capacity_ = 0;
+            }
+            if (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value) {
+                allocator_ = std::move(Right.allocator_);
+            }
+            std::swap(data_, Right.data_);
+            std::swap(capacity_, Right.capacity_);
+            std::swap(head_, Right.head_);
+            std::swap(size_, Right.size_);
+        }
+        return *this;
+    }
+
+    Circular_deque& operator=(std::initializer_list<T> IList) {
+        assign(IList.begin(), IList.end());
+        return *this;
+    }
+
+    //将元素从容器中清除并将一组新的元素序列复制进来
+    template <class InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
+    void assign(InputIterator First, InputIterator Last) {
+        clear();
+        using IteratorCategory = typename std::iterator_traits<InputIterator>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, IteratorCategory>) {
+            reserve(static_cast<size_type>(std::distance(First, Last)));
+        }
+        for (; First != Last; ++First) {
+            emplace_back(*First);
+        }
+    }
+
+    void assign(size_type Count, const T& Val) {
+        clear();
+        reserve(Count);
+        for (size_type i = 0; i < Count; ++i) {
+            emplace_back(Val);
+        }
+    }
+
+    void assign(std::initializer_list<T> IList) {
+        assign(IList.begin(), IList.end());
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_;
+    }
+
+    //元素访问
+    reference operator[](size_type index) {
+        return *slot(index);
+    }
+
+    const_reference operator[](size_type index) const {
+        return *slot(index);
+    }
+
+    reference at(size_type index) {
+        if (index >= size_) {
+            throw std::out_of_range("Circular_deque : at");
+        }
+        return *slot(index);
+    }
+
+    const_reference at(size_type index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Circular_deque : at");
+        }
+        return *slot(index);
+    }
+
+    reference front() {
+        return data_[head_];
+    }
+
+    const_reference front() const {
+        return data_[head_];
+    }
+
+    reference back() {
+        return *slot(size_ - 1);
+    }
+
+    const_reference back() const {
+        return *slot(size_ - 1);
+    }
+
+    // 迭代器
+    iterator begin() noexcept {
+        return iterator(data_, mask(), head_, 0);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(data_, mask(), head_, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(data_, mask(), head_, size_);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(data_, mask(), head_, size_);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    // 容量操作
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type max_size() const noexcept {
+        return (size_t(-1) / 2) / sizeof(T);
+    }
+
+    size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    // 容量已用满，下一次 push 会重新分配
+    bool full() const noexcept {
+        return size_ == capacity_;
+    }
+
+    // 预留至少 n 个元素的空间，容量取整到 2 的幂
+    void reserve(size_type n) {
+        if (n > capacity_) {
+            reallocate(S_round_up(n));
+        }
+    }
+
+    //放弃额外容量：缩到能放下全部元素的 2 的幂，空容器释放缓冲区
+    void shrink_to_fit() {
+        size_t new_capacity = size_ ? S_round_up(size_) : 0;
+        if (new_capacity < capacity_) {
+            reallocate(new_capacity);
+        }
+    }
+
+    // 修改操作
+    void clear() noexcept {
+        destroy_all();
+        head_ = 0;
+        size_ = 0;
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            grow_and_emplace(size_, std::forward<Args>(args)...);
+            return;
+        }
+        allocator_.construct(slot(size_), std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        if (size_ == capacity_) {
+            grow_and_emplace(0, std::forward<Args>(args)...);
+            return;
+        }
+        size_t new_head = (head_ - 1) & mask();
+        allocator_.construct(data_ + new_head, std::forward<Args>(args)...);
+        head_ = new_head;
+        ++size_;
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    void push_front(T&& value) {
+        emplace_front(std::move(value));
+    }
+
+    void pop_front() {
+        if (size_ == 0) return;
+        allocator_.destroy(data_ + head_);
+        head_ = (head_ + 1) & mask();
+        --size_;
+    }
+
+    void pop_back() {
+        if (size_ == 0) return;
+        --size_;
+        allocator_.destroy(slot(size_));
+    }
+
+    // 在 Where 处就地构造元素，移动较短的一侧
+    template <typename... Args>
+    iterator emplace(const_iterator Where, Args&&... args) {
+        size_type index = static_cast<size_type>(Where - cbegin());
+        if (index == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+        if (index == 0) {
+            emplace_front(std::forward<Args>(args)...);
+            return begin();
+        }
+
+        T value(std::forward<Args>(args)...);
+        if (index < size_ / 2) {
+            // 前半部分：[0, index) 整体前移一位
+            emplace_front(std::move(front()));
+            iterator first = begin();
+            std::move(first + 2, first + (index + 1), first + 1);
+        } else {
+            // 后半部分：[index, size) 整体后移一位
+            emplace_back(std::move(back()));
+            iterator first = begin();
+            std::move_backward(first + index, first + (size_ - 2), first + (size_ - 1));
+        }
+        (*this)[index] = std::move(value);
+        return begin() + index;
+    }
+
+    //将一个、多个或一系列元素插入到指定位置
+    iterator insert(const_iterator Where, const value_type& Val) {
+        return emplace(Where, Val);
+    }
+
+    iterator insert(const_iterator Where, value_type&& Val) {
+        return emplace(Where, std::move(Val));
+    }
+
+    // 先追加到尾部，再旋转到位
+    iterator insert(const_iterator Where, size_type Count, const value_type& Val) {
+        size_type index = static_cast<size_type>(Where - cbegin());
+        size_type old_size = size_;
+        if (Count > 0 && size_ + Count > capacity_) {
+            T copy(Val);    // Val 可能引用容器中的元素
+            reserve(size_ + Count);
+            for (size_type i = 0; i < Count; ++i) {
+                emplace_back(copy);
+            }
+        } else {
+            for (size_type i = 0; i < Count; ++i) {
+                emplace_back(Val);
+            }
+        }
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+    }
+
+    template <class InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
+    iterator insert(const_iterator Where, InputIterator First, InputIterator Last) {
+        size_type index = static_cast<size_type>(Where - cbegin());
+        size_type old_size = size_;
+        using IteratorCategory = typename std::iterator_traits<InputIterator>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, IteratorCategory>) {
+            reserve(size_ + static_cast<size_type>(std::distance(First, Last)));
+        }
+        for (; First != Last; ++First) {
+            emplace_back(*First);
+        }
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator Where, std::initializer_list<value_type> IList) {
+        return insert(Where, IList.begin(), IList.end());
+    }
+
+    //删除一个或一系列元素，移动较短的一侧
+    iterator erase(const_iterator Where) {
+        return erase(Where, Where + 1);
+    }
+
+    iterator erase(const_iterator First, const_iterator Last) {
+        size_type index = static_cast<size_type>(First - cbegin());
+        size_type n = static_cast<size_type>(Last - First);
+        if (n == 0) {
+            return begin() + index;
+        }
+        iterator first = begin();
+        if (index < size_ - index - n) {
+            // 前面的元素少：[0, index) 整体后移 n 位
+            std::move_backward(first, first + index, first + (index + n));
+            for (size_type i = 0; i < n; ++i) {
+                pop_front();
+            }
+        } else {
+            // 后面的元素少：[index + n, size) 整体前移 n 位
+            std::move(first + (index + n), end(), first + index);
+            for (size_type i = 0; i < n; ++i) {
+                pop_back();
+            }
+        }
+        return begin() + index;
+    }
+
+    //为容器指定新的大小
+    void resize(size_type Newsize) {
+        if (Newsize > size_) {
+            reserve(Newsize);
+            while (size_ < Newsize) {
+                emplace_back();
+            }
+        } else {
+            while (size_ > Newsize) {
+                pop_back();
+            }
+        }
+    }
+
+    void resize(size_type Newsize, const value_type& Val) {
+        if (Newsize > size_) {
+            insert(cend(), Newsize - size_, Val);
+        } else {
+            while (size_ > Newsize) {
+                pop_back();
+            }
+        }
+    }
+
+    void swap(Circular_deque& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+        if (std::allocator_traits<Alloc>::propagate_on_container_swap::value) {
+            std::swap(allocator_, other.allocator_);
+        }
+    }
+};
+
+template <typename T, typename Alloc>
+inline bool operator==(const Circular_deque<T, Alloc>& x, const Circular_deque<T, Alloc>& y) {
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+template <typename T, typename Alloc>
+inline bool operator!=(const Circular_deque<T, Alloc>& x, const Circular_deque<T, Alloc>& y) {
+    return !(x == y);
+}
+
+template <typename T, typename Alloc>
+inline bool operator<(const Circular_deque<T, Alloc>& x, const Circular_deque<T, Alloc>& y) {
+    return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <typename T, typename Alloc>
+inline bool operator>(const Circular_deque<T, Alloc>& x, const Circular_deque<T, Alloc>& y) {
+    return y < x;
+}
+
+template <typename T, typename Alloc>
+inline bool operator<=(const Circular_deque<T, Alloc>& x, const Circular_deque<T, Alloc>& y) {
+    return !(y < x);
+}
+
+template <typename T, typename Alloc>
+inline bool operator>=(const Circular_deque<T, Alloc>& x, const Circular_deque<T, Alloc>& y) {
+    return !(x < y);
+}
+
+template <typename T, typename Alloc>
+inline void swap(Circular_deque<T, Alloc>& x, Circular_deque<T, Alloc>& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+}
+
+// 只持有缓冲区指针和下标，整体按字节搬动即可
+template <typename T>
+struct Is_trivially_relocatable<Circular_deque<T, Allocator<T>>> : std::true_type {};
+
+#endif // CIRCULAR_DEQUE_H
@@ -0,0 +1,673 @@
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include "allocator.h"
+#include "queue.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// 无锁队列的公共参数
+struct Concurrent_queue_config{
+    static constexpr size_t S_cache_line = 64;   // 头尾下标各占一条缓存行，避免生产者与消费者伪共享
+    static constexpr size_t S_spin_limit = 64;   // 阻塞操作先自旋这么多次再让出 CPU
+
+    // 容量向上取整到 2 的幂，下标用掩码回绕
+    static size_t S_round_up(size_t n) noexcept {
+        size_t capacity = 2;
+        while (capacity < n) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    // 每个线程独立的 xorshift 随机数，用于挑选分片 / 窃取对象，不需要共享状态
+    static size_t S_random() noexcept {
+        thread_local size_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// 阻塞操作的退避：先用 pause 自旋，超过 S_spin_limit 次后改为 yield
+class Spin_backoff{
+public:
+    void M_wait() noexcept {
+        if (M_count < Concurrent_queue_config::S_spin_limit) {
+            ++M_count;
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    void M_reset() noexcept {
+        M_count = 0;
+    }
+
+private:
+    size_t M_count = 0;
+};
+
+// 单生产者单消费者的有界环形队列。
+// 只有一个线程调用 push 系列、一个线程调用 pop 系列；两侧各自缓存对方的下标，
+// 只在看起来满 / 空时才重新读取对方的原子变量，稳定状态下不会在两条缓存行之间来回争用。
+// try_ 系列不阻塞，失败立即返回；push / pop 在满 / 空时自旋等待。
+// 批量操作 push_n / pop_n 一次发布多个元素，只做一次 release 写
+template <typename T, typename Alloc = Allocator<T>>
+class Spsc_queue{
+public:
+    using value_type     = T;
+    using size_type      = size_t;
+    using allocator_type = Alloc;
+
+    // 容量向上取整到 2 的幂
+    explicit Spsc_queue(size_type capacity, const Alloc& a = Alloc())
+        : M_allocator(a),
+          M_capacity(Concurrent_queue_config::S_round_up(capacity)),
+          M_mask(M_capacity - 1),
+          M_buffer(M_allocator.allocate(M_capacity)) {}
+
+    Spsc_queue(const Spsc_queue&) = delete;
+    Spsc_queue& operator=(const Spsc_queue&) = delete;
+
+    ~Spsc_queue() {
+        size_t head = M_head.load(std::memory_order_relaxed);
+        size_t tail = M_tail.load(std::memory_order_relaxed);
+        for (; head != tail; ++head) {
+            M_allocator.destroy(M_buffer + (head & M_mask));
+        }
+        M_allocator.deallocate(M_buffer, M_capacity);
+    }
+
+    // ---------------- 生产者 ----------------
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t tail = M_tail.load(std::memory_order_relaxed);
+        if (tail - M_head_cache == M_capacity) {
+            M_head_cache = M_head.load(std::memory_order_acquire);
+            if (tail - M_head_cache == M_capacity) {
+                return false;
+            }
+        }
+        M_allocator.construct(M_buffer + (tail & M_mask), std::forward<Args>(args)...);
+        M_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& value) {
+        return try_emplace(value);
+    }
+
+    bool try_push(T&& value) {
+        return try_emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        Spin_backoff backoff;
+        while (!try_emplace(std::forward<Args>(args)...)) {
+            backoff.M_wait();
+        }
+    }
+
+    void push(const T& value) {
+        emplace(value);
+    }
+
+    void push(T&& value) {
+        emplace(std::move(value));
+    }
+
+    // 从 first 起最多拷入 n 个元素，能放多少放多少，返回实际入队的个数
+    template <typename InputIterator>
+    size_type try_push_n(InputIterator first, size_type n) {
+        size_t tail = M_tail.load(std::memory_order_relaxed);
+        size_t room = M_capacity - (tail - M_head_cache);
+        if (room < n) {
+            M_head_cache = M_head.load(std::memory_order_acquire);
+            room = M_capacity - (tail - M_head_cache);
+        }
+        size_type count = n < room ? n : room;
+        for (size_type i = 0; i < count; ++i, ++first) {
+            M_allocator.construct(M_buffer + ((tail + i) & M_mask), *first);
+        }
+        if (count) {
+            M_tail.store(tail + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // 全部 n 个元素入队后返回，队列满时等待
+    template <typename InputIterator>
+    void push_n(InputIterator first, size_type n) {
+        Spin_backoff backoff;
+        while (n) {
+            size_type count = try_push_n(first, n);
+            if (count) {
+                std::advance(first, count);
+                n -= count;
+                backoff.M_reset();
+            } else {
+                backoff.M_wait();
+            }
+        }
+    }
+
+    // ---------------- 消费者 ----------------
+
+    bool try_pop(T& out) {
+        size_t head = M_head.load(std::memory_order_relaxed);
+        if (head == M_tail_cache) {
+            M_tail_cache = M_tail.load(std::memory_order_acquire);
+            if (head == M_tail_cache) {
+                return false;
+            }
+        }
+        T* slot = M_buffer + (head & M_mask);
+        out = std::move(*slot);
+        M_allocator.destroy(slot);
+        M_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void pop(T& out) {
+        Spin_backoff backoff;
+        while (!try_pop(out)) {
+            backoff.M_wait();
+        }
+    }
+
+    // 最多取出 n 个元素依次写入 out，返回实际出队的个数
+    template <typename OutputIterator>
+    size_type try_pop_n(OutputIterator out, size_type n) {
+        size_t head = M_head.load(std::memory_order_relaxed);
+        size_t ready = M_tail_cache - head;
+        if (ready < n) {
+            M_tail_cache = M_tail.load(std::memory_order_acquire);
+            ready = M_tail_cache - head;
+        }
+        size_type count = n < ready ? n : ready;
+        for (size_type i = 0; i < count; ++i, ++out) {
+            T* slot = M_buffer + ((head + i) & M_mask);
+            *out = std::move(*slot);
+            M_allocator.destroy(slot);
+        }
+        if (count) {
+            M_head.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // 取满 n 个元素后返回，队列空时等待
+    template <typename OutputIterator>
+    void pop_n(OutputIterator out, size_type n) {
+        Spin_backoff backoff;
+        while (n) {
+            size_type count = try_pop_n(out, n);
+            if (count) {
+                std::advance(out, count);
+                n -= count;
+                backoff.M_reset();
+            } else {
+                backoff.M_wait();
+            }
+        }
+    }
+
+    // ---------------- 观察 ----------------
+
+    // 生产者、消费者之外的线程调用时只是近似值
+    size_type size() const noexcept {
+        size_t head = M_head.load(std::memory_order_acquire);
+        size_t tail = M_tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    size_type capacity() const noexcept {
+        return M_capacity;
+    }
+
+private:
+    // 两侧都只读的部分
+    Alloc        M_allocator;
+    const size_t M_capacity;
+    const size_t M_mask;
+    T* const     M_buffer;
+
+    // 消费者写 M_head，生产者只在看起来满时读取
+    alignas(Concurrent_queue_config::S_cache_line) std::atomic<size_t> M_head{0};
+    size_t M_tail_cache = 0;    // 消费者看到的 tail
+
+    // 生产者写 M_tail，消费者只在看起来空时读取；类按缓存行对齐，末尾不会与其他对象共享缓存行
+    alignas(Concurrent_queue_config::S_cache_line) std::atomic<size_t> M_tail{0};
+    size_t M_head_cache = 0;    // 生产者看到的 head
+};
+
+// 多生产者多消费者的有界队列（Vyukov 序号法）。
+// 每个槽位带一个序号：等于位置 pos 时可写入，等于 pos + 1 时可读取，读完置为 pos + 容量进入下一轮。
+// 生产者、消费者各自用一次 CAS 抢占位置，之后只访问自己的槽位；
+// 批量操作一次 CAS 抢占连续多个已就绪的槽位
+template <typename T, typename Alloc = Allocator<T>>
+class Mpmc_queue{
+private:
+    struct Cell{
+        std::atomic<size_t> M_sequence;
+        alignas(T) unsigned char M_storage[sizeof(T)];
+
+        T* M_ptr() noexcept {
+            return reinterpret_cast<T*>(M_storage);
+        }
+    };
+
+    using Cell_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Cell>;
+
+public:
+    using value_type     = T;
+    using size_type      = size_t;
+    using allocator_type = Alloc;
+
+    // 容量向上取整到 2 的幂
+    explicit Mpmc_queue(size_type capacity, const Alloc& a = Alloc())
+        : M_allocator(a),
+          M_capacity(Concurrent_queue_config::S_round_up(capacity)),
+          M_mask(M_capacity - 1),
+          M_cells(M_allocator.allocate(M_capacity)) {
+        for (size_t i = 0; i < M_capacity; ++i) {
+            ::new (static_cast<void*>(&M_cells[i].M_sequence)) std::atomic<size_t>(i);
+        }
+    }
+
+    Mpmc_queue(const Mpmc_queue&) = delete;
+    Mpmc_queue& operator=(const Mpmc_queue&) = delete;
+
+    ~Mpmc_queue() {
+        size_t head = M_dequeue_pos.load(std::memory_order_relaxed);
+        size_t tail = M_enqueue_pos.load(std::memory_order_relaxed);
+        for (; head != tail; ++head) {
+            M_cells[head & M_mask].M_ptr()->~T();
+        }
+        M_allocator.deallocate(M_cells, M_capacity);
+    }
+
+    // ---------------- 生产者 ----------------
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t pos = M_enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &M_cells[pos & M_mask];
+            size_t seq = cell->M_sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (M_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // 满：该槽位上一轮的元素还没被取走
+            } else {
+                pos = M_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void*>(cell->M_storage)) T(std::forward<Args>(args)...);
+        cell->M_sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& value) {
+        return try_emplace(value);
+    }
+
+    bool try_push(T&& value) {
+        return try_emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        Spin_backoff backoff;
+        while (!try_emplace(std::forward<Args>(args)...)) {
+            backoff.M_wait();
+        }
+    }
+
+    void push(const T& value) {
+        emplace(value);
+    }
+
+    void push(T&& value) {
+        emplace(std::move(value));
+    }
+
+    // 从 first 起最多拷入 n 个元素：先数出从 pos 开始连续可写的槽位，再一次 CAS 全部占下
+    template <typename InputIterator>
+    size_type try_push_n(InputIterator first, size_type n) {
+        if (n == 0) return 0;
+        size_t pos = M_enqueue_pos.load(std::memory_order_relaxed);
+        size_type count;
+        for (;;) {
+            count = 0;
+            while (count < n && count < M_capacity
+                   && M_cells[(pos + count) & M_mask].M_sequence.load(std::memory_order_acquire) == pos + count) {
+                ++count;
+            }
+            if (count == 0) {
+                size_t seq = M_cells[pos & M_mask].M_sequence.load(std::memory_order_acquire);
+                if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos) < 0) {
+                    return 0;
+                }
+                pos = M_enqueue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (M_enqueue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        for (size_type i = 0; i < count; ++i, ++first) {
+            Cell& cell = M_cells[(pos + i) & M_mask];
+            ::new (static_cast<void*>(cell.M_storage)) T(*first);
+            cell.M_sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // 全部 n 个元素入队后返回，队列满时等待
+    template <typename InputIterator>
+    void push_n(InputIterator first, size_type n) {
+        Spin_backoff backoff;
+        while (n) {
+            size_type count = try_push_n(first, n);
+            if (count) {
+                std::advance(first, count);
+                n -= count;
+                backoff.M_reset();
+            } else {
+                backoff.M_wait();
+            }
+        }
+    }
+
+    // ---------------- 消费者 ----------------
+
+    bool try_pop(T& out) {
+        size_t pos = M_dequeue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &M_cells[pos & M_mask];
+            size_t seq = cell->M_sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (M_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // 空：该槽位本轮还没写入
+            } else {
+                pos = M_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        T* value = cell->M_ptr();
+        out = std::move(*value);
+        value->~T();
+        cell->M_sequence.store(pos + M_capacity, std::memory_order_release);
+        return true;
+    }
+
+    void pop(T& out) {
+        Spin_backoff backoff;
+        while (!try_pop(out)) {
+            backoff.M_wait();
+        }
+    }
+
+    // 最多取出 n 个元素依次写入 out：先数出从 pos 开始连续可读的槽位，再一次 CAS 全部占下
+    template <typename OutputIterator>
+    size_type try_pop_n(OutputIterator out, size_type n) {
+        if (n == 0) return 0;
+        size_t pos = M_dequeue_pos.load(std::memory_order_relaxed);
+        size_type count;
+        for (;;) {
+            count = 0;
+            while (count < n && count < M_capacity
+                   && M_cells[(pos + count) & M_mask].M_sequence.load(std::memory_order_acquire) == pos + count + 1) {
+                ++count;
+            }
+            if (count == 0) {
+                size_t seq = M_cells[pos & M_mask].M_sequence.load(std::memory_order_acquire);
+                if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1) < 0) {
+                    return 0;
+                }
+                pos = M_dequeue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (M_dequeue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        for (size_type i = 0; i < count; ++i, ++out) {
+            Cell& cell = M_cells[(pos + i) & M_mask];
+            T* value = cell.M_ptr();
+            *out = std::move(*value);
+            value->~T();
+            cell.M_sequence.store(pos + i + M_capacity, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // 取满 n 个元素后返回，队列空时等待
+    template <typename OutputIterator>
+    void pop_n(OutputIterator out, size_type n) {
+        Spin_backoff backoff;
+        while (n) {
+            size_type count = try_pop_n(out, n);
+            if (count) {
+                std::advance(out, count);
+                n -= count;
+                backoff.M_reset();
+            } else {
+                backoff.M_wait();
+            }
+        }
+    }
+
+    // ---------------- 观察 ----------------
+
+    // 并发修改时只是近似值：已占下位置但尚未完成的操作也计算在内
+    size_type size() const noexcept {
+        size_t head = M_dequeue_pos.load(std::memory_order_acquire);
+        size_t tail = M_enqueue_pos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    size_type capacity() const noexcept {
+        return M_capacity;
+    }
+
+private:
+    Cell_alloc_type M_allocator;
+    const size_t    M_capacity;
+    const size_t    M_mask;
+    Cell* const     M_cells;
+
+    alignas(Concurrent_queue_config::S_cache_line) std::atomic<size_t> M_enqueue_pos{0};
+    alignas(Concurrent_queue_config::S_cache_line) std::atomic<size_t> M_dequeue_pos{0};
+};
+
+// 松弛的并发优先队列（MultiQueue）。
+// 元素分散在 k 个各自带锁的 Priority_Queue 分片里：push 随机挑一个能立刻加锁的分片压入；
+// try_pop 随机挑两个分片，取两者堆顶中优先级更高的那个（two-choice）。
+// 线程之间很少争用同一把锁，可随核数扩展；代价是不保证严格按优先级出队，
+// 弹出的元素大致在全局前 O(k) 名之内。分片数一般取线程数的 2 到 4 倍
+template<typename T, typename Compare = std::less<T>, size_t Arity = 4>
+class Concurrent_priority_queue{
+private:
+    struct alignas(Concurrent_queue_config::S_cache_line) Shard{
+        std::mutex                                          M_mutex;
+        Priority_Queue<T, vector<T>, Compare, Arity>        M_heap;
+        std::atomic<size_t>                                 M_size{0};   // 加锁修改，无锁读取用于跳过空分片
+
+        void M_pop(T& out) {
+            M_heap.pop_n(1, &out);
+            M_size.store(M_heap.size(), std::memory_order_relaxed);
+        }
+    };
+
+public:
+    using value_type    = T;
+    using size_type     = size_t;
+    using value_compare = Compare;
+
+    explicit Concurrent_priority_queue(size_type shards = 4 * std::max<size_t>(std::thread::hardware_concurrency(), 1),
+                                       const Compare& cmp = Compare())
+        : M_count(std::max<size_type>(shards, 2)), M_shards(new Shard[M_count]), M_comp(cmp) {
+        for (size_type i = 0; i < M_count; ++i) {
+            M_shards[i].M_heap = Priority_Queue<T, vector<T>, Compare, Arity>(cmp);
+        }
+    }
+
+    Concurrent_priority_queue(const Concurrent_priority_queue&) = delete;
+    Concurrent_priority_queue& operator=(const Concurrent_priority_queue&) = delete;
+
+    // 随机尝试至多 S_spin_limit 个分片，全部正被占用时返回 false
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        for (size_t attempt = 0; attempt < Concurrent_queue_config::S_spin_limit; ++attempt) {
+            Shard& shard = M_shards[Concurrent_queue_config::S_random() % M_count];
+            std::unique_lock<std::mutex> lock(shard.M_mutex, std::try_to_lock);
+            if (lock.owns_lock()) {
+                M_insert(shard, std::forward<Args>(args)...);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool try_push(const T& value) {
+        return try_emplace(value);
+    }
+
+    bool try_push(T&& value) {
+        return try_emplace(std::move(value));
+    }
+
+    // 总会成功：随机尝试失败后阻塞在一个随机分片的锁上
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        for (size_t attempt = 0; attempt < Concurrent_queue_config::S_spin_limit; ++attempt) {
+            Shard& shard = M_shards[Concurrent_queue_config::S_random() % M_count];
+            std::unique_lock<std::mutex> lock(shard.M_mutex, std::try_to_lock);
+            if (lock.owns_lock()) {
+                M_insert(shard, std::forward<Args>(args)...);
+                return;
+            }
+        }
+        Shard& shard = M_shards[Concurrent_queue_config::S_random() % M_count];
+        std::lock_guard<std::mutex> lock(shard.M_mutex);
+        M_insert(shard, std::forward<Args>(args)...);
+    }
+
+    void push(const T& value) {
+        emplace(value);
+    }
+
+    void push(T&& value) {
+        emplace(std::move(value));
+    }
+
+    // 弹出一个优先级较高的元素。two-choice 随机尝试都不成功时逐个检查非空分片，
+    // 因此没有并发 push 时，只要队列非空就一定能取到元素；返回 false 表示队列为空
+    bool try_pop(T& out) {
+        for (size_t attempt = 0; attempt < Concurrent_queue_config::S_spin_limit; ++attempt) {
+            Shard* a = &M_shards[Concurrent_queue_config::S_random() % M_count];
+            Shard* b = &M_shards[Concurrent_queue_config::S_random() % M_count];
+            if (a->M_size.load(std::memory_order_relaxed) == 0) a = b;
+            if (b->M_size.load(std::memory_order_relaxed) == 0) b = a;
+            if (a->M_size.load(std::memory_order_relaxed) == 0) continue;
+
+            std::unique_lock<std::mutex> lock_a(a->M_mutex, std::try_to_lock);
+            std::unique_lock<std::mutex> lock_b;
+            if (b != a) {
+                lock_b = std::unique_lock<std::mutex>(b->M_mutex, std::try_to_lock);
+            }
+            Shard* best = M_better(lock_a.owns_lock() ? a : nullptr, lock_b.owns_lock() ? b : nullptr);
+            if (best) {
+                best->M_pop(out);
+                return true;
+            }
+        }
+        for (size_type i = 0; i < M_count; ++i) {
+            Shard& shard = M_shards[i];
+            if (shard.M_size.load(std::memory_order_relaxed) == 0) continue;
+            std::lock_guard<std::mutex> lock(shard.M_mutex);
+            if (!shard.M_heap.empty()) {
+                shard.M_pop(out);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 并发修改时只是近似值
+    size_type size() const noexcept {
+        size_type total = 0;
+        for (size_type i = 0; i < M_count; ++i) {
+            total += M_shards[i].M_size.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    size_type shard_count() const noexcept {
+        return M_count;
+    }
+
+private:
+    template <typename... Args>
+    static void M_insert(Shard& shard, Args&&... args) {
+        shard.M_heap.emplace(std::forward<Args>(args)...);
+        shard.M_size.store(shard.M_heap.size(), std::memory_order_relaxed);
+    }
+
+    // 两个已加锁的分片中堆顶优先级更高的一个，空分片或未加锁（nullptr）的不参与比较
+    Shard* M_better(Shard* a, Shard* b) const {
+        if (a && a->M_heap.empty()) a = nullptr;
+        if (b && b->M_heap.empty()) b = nullptr;
+        if (!a) return b;
+        if (!b) return a;
+        return M_comp(a->M_heap.top(), b->M_heap.top()) ? b : a;
+    }
+
+    const size_type          M_count;
+    std::unique_ptr<Shard[]> M_shards;
+    Compare                  M_comp;
+};
+
+#endif // CONCURRENT_QUEUE_H
@@ -5,10 +5,16 @@
 #include "vector.h"
 #include <cstring>
 #include <algorithm>
+#include <functional>
+#include <numeric>
 
-template <typename T, typename Alloc = Allocator<T>>
+// BlockBytes 为每个元素块的字节数，一块容纳 BlockBytes / sizeof(T) 个元素（至少 1 个）。
+// 元素较大或队列较长时调大它，例如 Queue<T, Deque<T, Allocator<T>, 4096>>
+template <typename T, typename Alloc = Allocator<T>, size_t BlockBytes = 512>
 class Deque;
 
+struct Deque_segments;
+
 // 迭代器类
 template <typename T, bool IsConst>
 class DequeIterator {
@@ -37,7 +43,10 @@ private:
     friend class DequeIterator;
 
 public:
-    friend class Deque<T>;
+    template <typename U, typename A, size_t B>
+    friend class Deque;
+
+    friend struct Deque_segments;
 
     // 迭代器标签，这里需要使用标准库定义的迭代器标签
     using iterator_category = std::random_access_iterator_tag;  // 修改为随机访问迭代器标签
@@ -74,17 +83,25 @@ public:
 
     // operator+= 重载
     DequeIterator& operator+=(difference_type n) {
+        difference_type buf_size = difference_type(this->deque_buf_size());
         difference_type offset = n + (cur - first);
         // 在同一块内
-        if (offset >= 0 && offset < difference_type(this->deque_buf_size())) {
+        if (offset >= 0 && offset < buf_size) {
             cur += n;
         }
         else {
-            difference_type block_offset = offset > 0 ? offset / difference_type(this->deque_buf_size()) : -difference_type((-offset - 1) / this->deque_buf_size());
-            // 切换至正确块
-            set_buf(block + block_offset);
-            // 切换至正确偏移量
-            cur = first + (offset - block_offset * difference_type(this->deque_buf_size()));
+            difference_type block_offset = offset > 0 ? offset / buf_size : -difference_type((-offset - 1) / buf_size) - 1;
+            // 恰好落在一块开头而那一块还没分配（只会是 end()）：与 ++ 一致，停在前一块末尾
+            if (offset > 0 && offset % buf_size == 0 && *(block + block_offset) == nullptr) {
+                set_buf(block + block_offset - 1);
+                cur = last;
+            }
+            else {
+                // 切换至正确块
+                set_buf(block + block_offset);
+                // 切换至正确偏移量
+                cur = first + (offset - block_offset * buf_size);
+            }
         }
         return *this;
     }
@@ -148,9 +165,20 @@ public:
         return cur;
     }
 
-    // 相等运算符重载，判断两个迭代器是否相等
+    // 相等运算符重载，判断两个迭代器是否相等。
+    // 只比较 cur 不够：池化 / 连续分配的块可能首尾相接，前一块的 last 恰好等于另一块的 first。
+    // 停在块末尾的迭代器与下一块开头表示同一位置，也视为相等
     bool operator==(const DequeIterator& other) const {
-        return other.cur == cur;
+        if (block == other.block) {
+            return cur == other.cur;
+        }
+        if (block + 1 == other.block) {
+            return cur == last && other.cur == other.first;
+        }
+        if (other.block + 1 == block) {
+            return other.cur == other.last && cur == first;
+        }
+        return false;
     }
 
     // 不等运算符重载，判断两个迭代器是否不等
@@ -158,9 +186,13 @@ public:
         return !(*this == other);
     }
 
-    // 小于运算符重载
+    // 小于运算符重载。跨块时按距离比较，与 operator== 保持一致：
+    // 停在块末尾的迭代器与下一块开头距离为 0，不算小于
     bool operator<(const DequeIterator& other) const {
-        return block < other.block || (block == other.block && cur < other.cur);
+        if (block == other.block) {
+            return cur < other.cur;
+        }
+        return (*this - other) < 0;
     }
 
     // 大于运算符重载
@@ -185,9 +217,230 @@ public:
 };
 
 
-template <typename T, typename Alloc>
+template <typename Iter>
+struct Is_deque_iterator : std::false_type {};
+
+template <typename T, bool IsConst>
+struct Is_deque_iterator<DequeIterator<T, IsConst>> : std::true_type {};
+
+// Deque 迭代器上的分段算法。
+// 逐元素 ++ 每一步都要检查块边界，+= 还要做除法；这里把区间拆成若干段连续内存，
+// 每段交给标准算法处理指针区间，平凡类型的 copy/move 走 memmove，fill/find/accumulate 可被向量化。
+// 源、目的任一侧是 Deque 迭代器都会按块切分，另一侧是普通迭代器时直接照搬
+struct Deque_segments{
+    // 对 [first, last) 的每段连续内存依次调用 f(begin, end)。
+    // 按元素个数推进，不比较块指针：停在块末尾的迭代器与下一块开头的迭代器表示同一位置
+    template <typename T, bool IsConst, typename Func>
+    static void S_for_each_segment(DequeIterator<T, IsConst> first, DequeIterator<T, IsConst> last, Func f) {
+        std::ptrdiff_t remaining = last - first;
+        while (remaining > 0) {
+            if (first.cur == first.last) {
+                first.set_buf(first.block + 1);
+                first.cur = first.first;
+            }
+            std::ptrdiff_t n = std::min<std::ptrdiff_t>(first.last - first.cur, remaining);
+            f(first.cur, first.cur + n);
+            first.cur += n;
+            remaining -= n;
+        }
+    }
+
+    // 同上，从后往前
+    template <typename T, bool IsConst, typename Func>
+    static void S_for_each_segment_backward(DequeIterator<T, IsConst> first, DequeIterator<T, IsConst> last, Func f) {
+        std::ptrdiff_t remaining = last - first;
+        while (remaining > 0) {
+            if (last.cur == last.first) {
+                last.set_buf(last.block - 1);
+                last.cur = last.last;
+            }
+            std::ptrdiff_t n = std::min<std::ptrdiff_t>(last.cur - last.first, remaining);
+            f(last.cur - n, last.cur);
+            last.cur -= n;
+            remaining -= n;
+        }
+    }
+
+    template <typename InputIt, typename OutputIt>
+    static OutputIt S_copy(InputIt first, InputIt last, OutputIt out) {
+        return S_transfer<false>(first, last, out);
+    }
+
+    template <typename InputIt, typename OutputIt>
+    static OutputIt S_move(InputIt first, InputIt last, OutputIt out) {
+        return S_transfer<true>(first, last, out);
+    }
+
+    template <typename BidirIt1, typename BidirIt2>
+    static BidirIt2 S_copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 out_last) {
+        return S_transfer_backward<false>(first, last, out_last);
+    }
+
+    template <typename BidirIt1, typename BidirIt2>
+    static BidirIt2 S_move_backward(BidirIt1 first, BidirIt1 last, BidirIt2 out_last) {
+        return S_transfer_backward<true>(first, last, out_last);
+    }
+
+    template <typename T, typename U>
+    static void S_fill(DequeIterator<T, false> first, DequeIterator<T, false> last, const U& value) {
+        S_for_each_segment(first, last, [&](T* b, T* e) { std::fill(b, e, value); });
+    }
+
+    // 返回第一个等于 value 的位置，没有则返回 last
+    template <typename T, bool IsConst, typename U>
+    static DequeIterator<T, IsConst> S_find(DequeIterator<T, IsConst> first, DequeIterator<T, IsConst> last,
+                                            const U& value) {
+        return S_find_if(first, last, [&](const T& x) { return x == value; });
+    }
+
+    template <typename T, bool IsConst, typename Pred>
+    static DequeIterator<T, IsConst> S_find_if(DequeIterator<T, IsConst> first, DequeIterator<T, IsConst> last,
+                                               Pred pred) {
+        std::ptrdiff_t remaining = last - first;
+        while (remaining > 0) {
+            if (first.cur == first.last) {
+                first.set_buf(first.block + 1);
+                first.cur = first.first;
+            }
+            std::ptrdiff_t n = std::min<std::ptrdiff_t>(first.last - first.cur, remaining);
+            auto p = std::find_if(first.cur, first.cur + n, pred);
+            if (p != first.cur + n) {
+                first.cur = p;
+                return first;
+            }
+            first.cur += n;
+            remaining -= n;
+        }
+        return last;
+    }
+
+    template <typename T, bool IsConst, typename Func>
+    static Func S_for_each(DequeIterator<T, IsConst> first, DequeIterator<T, IsConst> last, Func f) {
+        using Ptr = typename DequeIterator<T, IsConst>::pointer;
+        S_for_each_segment(first, last, [&](Ptr b, Ptr e) { std::for_each(b, e, std::ref(f)); });
+        return f;
+    }
+
+    template <typename T, bool IsConst, typename V>
+    static V S_accumulate(DequeIterator<T, IsConst> first, DequeIterator<T, IsConst> last, V init) {
+        using Ptr = typename DequeIterator<T, IsConst>::pointer;
+        S_for_each_segment(first, last, [&](Ptr b, Ptr e) { init = std::accumulate(b, e, std::move(init)); });
+        return init;
+    }
+
+    template <typename T, bool IsConst, typename V, typename BinaryOp>
+    static V S_accumulate(DequeIterator<T, IsConst> first, DequeIterator<T, IsConst> last, V init, BinaryOp op) {
+        using Ptr = typename DequeIterator<T, IsConst>::pointer;
+        S_for_each_segment(first, last, [&](Ptr b, Ptr e) { init = std::accumulate(b, e, std::move(init), op); });
+        return init;
+    }
+
+private:
+    template <bool Move, typename InputIt, typename OutputIt>
+    static OutputIt S_transfer_flat(InputIt first, InputIt last, OutputIt out) {
+        if constexpr (Move) {
+            return std::move(first, last, out);
+        } else {
+            return std::copy(first, last, out);
+        }
+    }
+
+    template <bool Move, typename BidirIt1, typename BidirIt2>
+    static BidirIt2 S_transfer_flat_backward(BidirIt1 first, BidirIt1 last, BidirIt2 out_last) {
+        if constexpr (Move) {
+            return std::move_backward(first, last, out_last);
+        } else {
+            return std::copy_backward(first, last, out_last);
+        }
+    }
+
+    // 源区间是 Deque 迭代器时按源的块切分，每段再交给 S_transfer_into
+    template <bool Move, typename InputIt, typename OutputIt>
+    static OutputIt S_transfer(InputIt first, InputIt last, OutputIt out) {
+        if constexpr (Is_deque_iterator<InputIt>::value) {
+            using Ptr = typename InputIt::pointer;
+            S_for_each_segment(first, last, [&](Ptr b, Ptr e) { out = S_transfer_into<Move>(b, e, out); });
+            return out;
+        } else {
+            return S_transfer_into<Move>(first, last, out);
+        }
+    }
+
+    // 目的是 Deque 迭代器且源可随机访问时按目的的块切分，其余情况直接用标准算法
+    template <bool Move, typename InputIt, typename OutputIt>
+    static OutputIt S_transfer_into(InputIt first, InputIt last, OutputIt out) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (Is_deque_iterator<OutputIt>::value
+                      && std::is_base_of_v<std::random_access_iterator_tag, Category>) {
+            auto remaining = last - first;
+            while (remaining > 0) {
+                if (out.cur == out.last) {
+                    out.set_buf(out.block + 1);
+                    out.cur = out.first;
+                }
+                auto n = std::min<std::ptrdiff_t>(out.last - out.cur, remaining);
+                S_transfer_flat<Move>(first, first + n, out.cur);
+                first += n;
+                remaining -= n;
+                out.cur += n;
+            }
+            // 与 ++ 保持一致：停在块末尾且后面还有块时跳到下一块开头
+            if (out.cur == out.last && *(out.block + 1) != nullptr) {
+                out.set_buf(out.block + 1);
+                out.cur = out.first;
+            }
+            return out;
+        } else {
+            return S_transfer_flat<Move>(first, last, out);
+        }
+    }
+
+    template <bool Move, typename BidirIt1, typename BidirIt2>
+    static BidirIt2 S_transfer_backward(BidirIt1 first, BidirIt1 last, BidirIt2 out_last) {
+        if constexpr (Is_deque_iterator<BidirIt1>::value) {
+            using Ptr = typename BidirIt1::pointer;
+            S_for_each_segment_backward(first, last, [&](Ptr b, Ptr e) {
+                out_last = S_transfer_into_backward<Move>(b, e, out_last);
+            });
+            return out_last;
+        } else {
+            return S_transfer_into_backward<Move>(first, last, out_last);
+        }
+    }
+
+    template <bool Move, typename BidirIt1, typename BidirIt2>
+    static BidirIt2 S_transfer_into_backward(BidirIt1 first, BidirIt1 last, BidirIt2 out_last) {
+        using Category = typename std::iterator_traits<BidirIt1>::iterator_category;
+        if constexpr (Is_deque_iterator<BidirIt2>::value
+                      && std::is_base_of_v<std::random_access_iterator_tag, Category>) {
+            auto remaining = last - first;
+            while (remaining > 0) {
+                if (out_last.cur == out_last.first) {
+                    out_last.set_buf(out_last.block - 1);
+                    out_last.cur = out_last.last;
+                }
+                auto n = std::min<std::ptrdiff_t>(out_last.cur - out_last.first, remaining);
+                S_transfer_flat_backward<Move>(last - n, last, out_last.cur);
+                last -= n;
+                remaining -= n;
+                out_last.cur -= n;
+            }
+            return out_last;
+        } else {
+            return S_transfer_flat_backward<Move>(first, last, out_last);
+        }
+    }
+};
+
+
+template <typename T, typename Alloc, size_t BlockBytes>
 class Deque{
 private:
+    static_assert(BlockBytes > 0, "Deque block size must be positive");
+
+    // 回收块缓存的容量：pop 空出的块先留在这里，push 需要新块时优先取用，
+    // 先进先出的稳定状态下不再反复向分配器申请、释放
+    static constexpr size_t S_max_spare_blocks = 8;
 
     // 缓冲区容纳元素个数， 元素大小超出缓冲区容量时为1
     size_t deque_buf_size(){
@@ -196,9 +449,11 @@ private:
     
     DequeIterator<T, false> head;
     DequeIterator<T, false> tail;
-    size_t block_size = 512; // 元素块大小
-    Vector<T*> blocks_;     // 块指针数组
+    size_t block_size = BlockBytes; // 元素块大小（字节）
+    Vector<T*> blocks_;     // 块指针数组，首尾各留一个恒为空的槽位，迭代器查看相邻块时不会越界
     Alloc allocator_;
+    T* spare_blocks_[S_max_spare_blocks]; // 回收的空块
+    size_t spare_count_ = 0;
 
 public:
     friend class DequeIterator<T, true>;
@@ -250,7 +505,7 @@ public:
     size_t blocks_index = 0;
     for (const T* it : Right.blocks_)   {  // 使用 const 引用 
         if (it != nullptr) {
-            blocks_[blocks_index] = allocator_.allocate(buf_size);
+            blocks_[blocks_index] = acquire_block();
             // 使用 memcpy（注意：可能不适用于非平凡类型，建议改用元素拷贝构造）
             memcpy(blocks_[blocks_index], it, buf_size * sizeof(T));
         } else {
@@ -294,11 +549,12 @@ public:
             clear();
             for (auto& block : blocks_) {
                 if (block) {
-                    allocator_.deallocate(block, block_size);
+                    allocator_.deallocate(block, deque_buf_size());
                     block = nullptr;
                 }
             }
             blocks_.clear();
+            drop_spare_blocks();
  
             if (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value) {
                 allocator_ = std::move(other.allocator_); 
@@ -359,18 +615,25 @@ public:
         clear();
         for(auto it = blocks_.begin(); it != blocks_.end(); ++it){
             if(*it != nullptr){
-                allocator_.deallocate(*it, block_size);
+                allocator_.deallocate(*it, deque_buf_size());
             }
         }
+        drop_spare_blocks();
     }
 
-    // 清空容器
+    // 清空容器：只保留 tail 所在的块，其余块交回缓存
     void clear(){
         while(head != tail){
             allocator_.destroy(head.cur);
             head++;
         }
-        head = tail = iterator();
+        for(auto it = blocks_.begin(); it != blocks_.end(); ++it){
+            if(*it != nullptr && &*it != tail.block){
+                release_block(*it);
+                *it = nullptr;
+            }
+        }
+        head = tail = iterator(tail.block, *tail.block, block_size);
     }
 
     reference back(){
@@ -404,19 +667,13 @@ public:
         if(head == tail) return;
 
         allocator_.destroy(head.cur);
-        //元素为最后一块时
-        if(head.cur == head.last){ 
-            auto temp = head.block + 1;
-            allocator_.deallocate(*head.block, block_size); //回收内存
-            *head.block = nullptr;
-            head.block = temp;   //head重新赋值
-            head.cur = head.first = *(tail.block);
-            head.last = head.first + deque_buf_size();
-        }
-        else{
-            ++head;
+        T** old_block = head.block;
+        ++head;
+        //head 跨入下一块时，原来的块已经空了，交回缓存
+        if(head.block != old_block){
+            release_block(*old_block);
+            *old_block = nullptr;
         }
-
     }
 
     // 插入元素到尾部
@@ -435,7 +692,7 @@ public:
         //元素为最后一块时
         if(tail.cur == tail.first){
             auto temp = tail.block - 1;
-            allocator_.deallocate(*tail.block, block_size);
+            release_block(*tail.block);
             *tail.block = nullptr;
             tail.block = temp;   // tail重新赋值
             tail.cur = tail.last = *(tail.block) + deque_buf_size();
@@ -527,13 +784,14 @@ public:
             size_type required_blocks = (n + buf_size - 1) / buf_size;
             size_type num_blocks = required_blocks + 2; // 前后哨兵块
 
-            blocks_.resize(num_blocks, nullptr);
-            for (size_t i = 0; i < num_blocks; ++i) {
-                blocks_[i] = allocator_.allocate(buf_size);
+            release_all_blocks();
+            blocks_.resize(num_blocks + 2, nullptr);
+            for (size_t i = 1; i <= num_blocks; ++i) {
+                blocks_[i] = acquire_block();
             }
 
             // 设置头尾到中间块
-            size_type mid_block = num_blocks / 2;
+            size_type mid_block = num_blocks / 2 + 1;
             size_type head_block_idx = mid_block - (required_blocks / 2);
             head = iterator(&blocks_[head_block_idx], blocks_[head_block_idx], block_size);
             tail = head;
@@ -572,15 +830,15 @@ public:
             size_t old_cap = blocks_.size();
             try{
                 //缓冲区不足时扩充
-                if(head.block == &blocks_[0]){
-                    expand_blocks();
-                    *(head.block - 1) = allocator_.allocate(deque_buf_size());
+                if(head.block - 1 == &blocks_[0]){
+                    make_room_front();
+                    *(head.block - 1) = acquire_block();
                     head.set_buf(head.block - 1);
                     head.cur = head.last;
                 }
                 //跳转至前一个缓冲区
                 else if(*(head.block - 1) == nullptr){
-                    *(head.block - 1) = allocator_.allocate(deque_buf_size());
+                    *(head.block - 1) = acquire_block();
                     head.set_buf(head.block - 1);
                     head.cur = head.last;
                 }
@@ -598,14 +856,15 @@ public:
         // 检查是否需要扩展尾部块
         if (tail.cur == tail.last) {
             size_t old_cap = blocks_.size();
+            bool was_empty = head == tail;
             try {
-                if (tail.block == &blocks_.back()) {
-                    expand_blocks();
-                    *(tail.block + 1) = allocator_.allocate(deque_buf_size());
+                if (tail.block + 1 == &blocks_.back()) {
+                    make_room_back();
+                    *(tail.block + 1) = acquire_block();
                     tail.set_buf(tail.block + 1);
                     tail.cur = tail.first;
                 } else if (*(tail.block + 1) == nullptr) {
-                    *(tail.block + 1) = allocator_.allocate(deque_buf_size());
+                    *(tail.block + 1) = acquire_block();
                     tail.set_buf(tail.block + 1);
                     tail.cur = tail.first;
                 }
@@ -613,6 +872,10 @@ public:
                 blocks_.resize(old_cap);
                 throw;
             }
+            // 空容器时 head 与 tail 一起停在旧块末尾，跟着挪到新块开头
+            if (was_empty) {
+                head = tail;
+            }
         }
         allocator_.construct(tail.cur, std::forward<Args>(args)...); // 直接构造元素
         ++tail; // 移动尾指针到下一个位置
@@ -633,15 +896,19 @@ public:
         }
 
         // 中间插入，需要移动元素
+        // 两端扩展可能重新分配块指针数组，之后按下标重新定位
         size_type index = where - head;
         if (index < size() / 2) {
-            // 前半部分，移动前面的元素
+            // 前半部分，[head, where) 整体前移一位
             emplace_front(T());
-            std::move(head + 1, where + 1, head);
+            where = head + (index + 1);
+            Deque_segments::S_move(head + 1, where, head);
+            --where;
         } else {
-            // 后半部分，移动后面的元素
+            // 后半部分，[where, tail) 整体后移一位
             emplace_back(T());
-            std::move_backward(where, tail - 1, tail);
+            where = head + index;
+            Deque_segments::S_move_backward(where, tail - 1, tail);
         }
 
         // 在腾出的位置构造元素
@@ -654,21 +921,18 @@ public:
     iterator erase(iterator where) {
         if (where == end()) return where;
 
-        // 销毁目标元素
-        allocator_.destroy(&*where);
-
-        // 判断删除位置在前半还是后半
+        // 判断删除位置在前半还是后半，被删元素由搬移覆盖，多出的一个由 pop 销毁
         size_type index = where - head;
         if (index < size() / 2) {
             // 前半部分：将 [head, where) 的元素向后移动一位，覆盖where
-            std::move_backward(head, where, where + 1);
+            Deque_segments::S_move_backward(head, where, where + 1);
             pop_front(); // 调整头部
         } else {
             // 后半部分：将 [where+1, tail) 的元素向前移动一位，覆盖where
-            std::move(where + 1, tail, where);
+            Deque_segments::S_move(where + 1, tail, where);
             pop_back(); // 调整尾部
         }
-        return where;
+        return head + index;
     }
 
     iterator erase(iterator first, iterator last) {
@@ -681,20 +945,20 @@ public:
         size_type index = first - head;
         if (index < size() / 2) {
             // 前半部分：将 [head, first) 的元素向后移动n位
-            std::move_backward(head, first, last);
+            Deque_segments::S_move_backward(head, first, last);
             // 销毁并调整头部
             for (auto it = head; it != head + n; ++it)
                 allocator_.destroy(&*it);
             head += n;
         } else {
             // 后半部分：将 [last, tail) 的元素向前移动n位
-            std::move(last, tail, first);
+            Deque_segments::S_move(last, tail, first);
             // 销毁并调整尾部
             for (auto it = tail - n; it != tail; ++it)
                 allocator_.destroy(&*it);
             tail -= n;
         }
-        return first;
+        return head + index;
     }
 
     //返回用于构造 deque 的分配器对象的一个副本
@@ -786,66 +1050,65 @@ public:
         // 如果 _Newsize == current_size，无需操作
     }
 
-    //放弃额外容量
+    //放弃额外容量：释放缓存的空块以及头尾之外预留的块
     void shrink_to_fit(){
-        size_t block_count = 0; //有元素的缓冲区个数
-        size_t block_front_IsNullptr_count = 0; //前导为空的元素块个数
-        for(auto it = blocks_.begin(); it != blocks_.end(); ++it){
-            if(*it != nullptr){
-                ++block_count;
+        drop_spare_blocks();
+        T** base = blocks_.data();
+        for(T** p = base; p != head.block; ++p){
+            if(*p != nullptr){
+                allocator_.deallocate(*p, deque_buf_size());
+                *p = nullptr;
             }
-            if(!block_count && *it == nullptr){
-                ++block_front_IsNullptr_count;
+        }
+        for(T** p = tail.block + 1; p != base + blocks_.size(); ++p){
+            if(*p != nullptr){
+                allocator_.deallocate(*p, deque_buf_size());
+                *p = nullptr;
             }
         }
-        // 有元素的块移动到前面
-        std::rotate(head, head + block_front_IsNullptr_count, head + block_front_IsNullptr_count + block_count);
-        // 清除后面为空的块
-        blocks_.resize(block_count);
     }
     
     void swap(Deque &other) noexcept;
 
     //重载比较运算符
-    template<typename _Tp, typename _Alloc>
-    bool operator==(const Deque<_Tp, _Alloc>& __y) const { 
+    template<typename _Tp, typename _Alloc, size_t _Bytes>
+    bool operator==(const Deque<_Tp, _Alloc, _Bytes>& __y) const { 
         return size() == __y.size() && std::equal(cbegin(), cend(), __y.cbegin()); 
     }
 
-    template<typename _Tp, typename _Alloc>
-    bool operator!=(const Deque<_Tp, _Alloc>& __y) const { 
+    template<typename _Tp, typename _Alloc, size_t _Bytes>
+    bool operator!=(const Deque<_Tp, _Alloc, _Bytes>& __y) const { 
         return !(*this == __y); 
     }
 
-    template<typename _Tp, typename _Alloc>
-    bool operator<(const Deque<_Tp, _Alloc>& __y) const { 
+    template<typename _Tp, typename _Alloc, size_t _Bytes>
+    bool operator<(const Deque<_Tp, _Alloc, _Bytes>& __y) const { 
         return std::lexicographical_compare(cbegin(), cend(), __y.cbegin(), __y.cend()); 
     }
 
-    template<typename _Tp, typename _Alloc>
-    bool operator>(const Deque<_Tp, _Alloc>& __y) const { 
+    template<typename _Tp, typename _Alloc, size_t _Bytes>
+    bool operator>(const Deque<_Tp, _Alloc, _Bytes>& __y) const { 
         return __y < *this; 
     }
 
-    template<typename _Tp, typename _Alloc>
-    bool operator<=(const Deque<_Tp, _Alloc>& __y) const { 
+    template<typename _Tp, typename _Alloc, size_t _Bytes>
+    bool operator<=(const Deque<_Tp, _Alloc, _Bytes>& __y) const { 
         return !(__y < *this); 
     }
 
-    template<typename _Tp, typename _Alloc>
-    bool operator>=(const Deque<_Tp, _Alloc>& __y) const { 
+    template<typename _Tp, typename _Alloc, size_t _Bytes>
+    bool operator>=(const Deque<_Tp, _Alloc, _Bytes>& __y) const { 
         return !(*this < __y); 
     }
 
 private:
     // 初始化
     void initialize(){
-        blocks_.resize(2, nullptr);
-        size_t buf_size = deque_buf_size();
-        blocks_[0] = allocator_.allocate(buf_size);
-        blocks_[1] = allocator_.allocate(buf_size);
-        head = iterator(&blocks_[1], blocks_[1], block_size);
-        tail = iterator(&blocks_[1], blocks_[1], block_size);
+        blocks_.resize(4, nullptr);
+        blocks_[1] = acquire_block();
+        blocks_[2] = acquire_block();
+        head = iterator(&blocks_[2], blocks_[2], block_size);
+        tail = iterator(&blocks_[2], blocks_[2], block_size);
     }
 
     // 扩充blocks_数组
@@ -865,6 +1128,92 @@ private:
         blocks_.swap(new_blocks);
     }
 
+    // head 到了块指针数组开头：后面空闲的槽位超过一半时把在用区段挪回中间，否则扩充
+    void make_room_front() {
+        size_t back_free = blocks_.data() + blocks_.size() - 1 - tail.block;
+        if (back_free > blocks_.size() / 2) {
+            recentre_blocks();
+        } else {
+            expand_blocks();
+        }
+    }
+
+    // tail 到了块指针数组末尾：同上，看前面空闲的槽位。
+    // 先进先出时 head 不断后移，前面总会空出来，块指针数组不再无限翻倍
+    void make_room_back() {
+        size_t front_free = head.block - blocks_.data();
+        if (front_free > blocks_.size() / 2) {
+            recentre_blocks();
+        } else {
+            expand_blocks();
+        }
+    }
+
+    // 把 [head.block, tail.block] 挪到块指针数组中间，区段外残留的块交回缓存
+    void recentre_blocks() {
+        T** base = blocks_.data();
+        T** end = base + blocks_.size();
+        for (T** p = base; p != head.block; ++p) {
+            if (*p != nullptr) {
+                release_block(*p);
+                *p = nullptr;
+            }
+        }
+        for (T** p = tail.block + 1; p != end; ++p) {
+            if (*p != nullptr) {
+                release_block(*p);
+                *p = nullptr;
+            }
+        }
+
+        size_t used = tail.block - head.block + 1;
+        T** new_head = base + (blocks_.size() - used) / 2;
+        if (new_head < head.block) {
+            std::copy(head.block, tail.block + 1, new_head);
+        } else if (new_head > head.block) {
+            std::copy_backward(head.block, tail.block + 1, new_head + used);
+        }
+        std::fill(base, new_head, nullptr);
+        std::fill(new_head + used, end, nullptr);
+
+        tail.block = new_head + (tail.block - head.block);
+        head.block = new_head;
+    }
+
+    // 取一个空块，优先复用缓存
+    T* acquire_block() {
+        if (spare_count_ != 0) {
+            return spare_blocks_[--spare_count_];
+        }
+        return allocator_.allocate(deque_buf_size());
+    }
+
+    // 归还一个空块，缓存满了才还给分配器
+    void release_block(T* block) noexcept {
+        if (spare_count_ < S_max_spare_blocks) {
+            spare_blocks_[spare_count_++] = block;
+        } else {
+            allocator_.deallocate(block, deque_buf_size());
+        }
+    }
+
+    // 释放缓存中的全部空块
+    void drop_spare_blocks() noexcept {
+        while (spare_count_ != 0) {
+            allocator_.deallocate(spare_blocks_[--spare_count_], deque_buf_size());
+        }
+    }
+
+    // 所有块交回缓存，块指针数组清空（调用前元素必须已经销毁）
+    void release_all_blocks() noexcept {
+        for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+            if (*it != nullptr) {
+                release_block(*it);
+            }
+        }
+        blocks_.clear();
+    }
+
     //初始化为count个val
     void initialize_count_val(size_type Count, const T &Val){
         size_type buf_size = deque_buf_size();
@@ -873,19 +1222,20 @@ private:
         size_type required_blocks = (Count > 0) ? (Count + buf_size - 1) / buf_size : 0;
         size_type num_blocks = required_blocks + 2; // 前后各留一个哨兵块
 
+        release_all_blocks();
         try {
             // 预分配块并初始化
-            blocks_.resize(num_blocks, nullptr);
-            for (size_t i = 0; i < num_blocks; ++i) {
-                blocks_[i] = allocator_.allocate(buf_size);
+            blocks_.resize(num_blocks + 2, nullptr);
+            for (size_t i = 1; i <= num_blocks; ++i) {
+                blocks_[i] = acquire_block();
             }
 
             // 初始化头尾
             size_type head_offset = Count / 2;
             size_type head_buf_offset = head_offset / buf_size;
             head_offset -= head_buf_offset * buf_size;
-            head = iterator(&blocks_[num_blocks / 2 - head_buf_offset], 
-                            blocks_[num_blocks / 2 - head_buf_offset], block_size);
+            head = iterator(&blocks_[num_blocks / 2 + 1 - head_buf_offset], 
+                            blocks_[num_blocks / 2 + 1 - head_buf_offset], block_size);
             tail = head;
 
             // 批量填充元素
@@ -895,7 +1245,7 @@ private:
                 size_type to_construct = std::min(available, elements_remaining);
 
                 // 构造元素
-                std::uninitialized_fill_n(tail.cur, to_construct, T());
+                std::uninitialized_fill_n(tail.cur, to_construct, Val);
                 tail += to_construct;
                 elements_remaining -= to_construct;
             }
@@ -903,7 +1253,7 @@ private:
         } catch (...) {
             // 异常安全：释放所有已分配块
             for (auto ptr : blocks_) {
-                if (ptr) allocator_.deallocate(ptr, buf_size);
+                if (ptr) release_block(ptr);
             }
             blocks_.clear();
             throw;
@@ -912,19 +1262,21 @@ private:
 
 };
 
-template <typename Type, typename other_Alloc>
-    void Deque<Type, other_Alloc>::swap(Deque& other) noexcept {
+template <typename Type, typename other_Alloc, size_t BlockBytes>
+    void Deque<Type, other_Alloc, BlockBytes>::swap(Deque& other) noexcept {
         std::swap(head, other.head);
         std::swap(tail, other.tail);
         std::swap(block_size, other.block_size);
         blocks_.swap(other.blocks_);
+        std::swap(spare_blocks_, other.spare_blocks_);
+        std::swap(spare_count_, other.spare_count_);
         if (std::allocator_traits<other_Alloc>::propagate_on_container_swap::value) {
             std::swap(allocator_, other.allocator_);
         }
     }
 
-template <class Type, class Allocator>
-void swap(Deque<Type, Allocator>& left, Deque<Type, Allocator>& right) noexcept(noexcept(left.swap(right))) {
+template <class Type, class Allocator, size_t BlockBytes>
+void swap(Deque<Type, Allocator, BlockBytes>& left, Deque<Type, Allocator, BlockBytes>& right) noexcept(noexcept(left.swap(right))) {
     left.swap(right);
 }
 
@@ -0,0 +1,386 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <bits/functexcept.h>
+#include <bits/concept_check.h>
+#include <initializer_list>
+#include <tuple>
+#include "flat_tree.h"
+
+// 有序 Vector 存放的映射，接口与 Map 一致。
+// 键值对连续存放，每个元素只占 sizeof(pair)，没有红黑树节点的三个指针与颜色。
+// 元素需要在数组中搬移，value_type 为 pair<Key, Value>（键不是 const），不要通过迭代器修改键；
+// 插入、删除使迭代器和引用失效。批量数据请用区间 insert / 区间构造
+template <typename Key, typename Value, typename Compare = less<Key>,
+          typename Alloc = Allocator<pair<Key, Value>>>
+class Flat_map{
+
+public:
+    using value_type      = std::pair<Key, Value>;
+
+private:
+    using Pair_alloc_type = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<value_type>::other;
+    using Rep_type        = Flat_tree<Key, value_type, _Select1st<value_type>, Compare, Pair_alloc_type>;
+
+    Rep_type M_t;
+
+public:
+
+    class value_compare {
+        friend class Flat_map<Key, Value, Compare, Alloc>;
+    protected:
+        Compare comp;
+
+        value_compare(Compare c) : comp(c) {}
+
+    public:
+        bool operator()(const value_type& x, const value_type& y) const {
+            return comp(x.first, y.first);
+        }
+    };
+
+    using pointer                = typename Rep_type::pointer;
+    using const_pointer          = typename Rep_type::const_pointer;
+    using reference              = typename Rep_type::reference;
+    using const_reference        = typename Rep_type::const_reference;
+    using iterator               = typename Rep_type::iterator;
+    using const_iterator         = typename Rep_type::const_iterator;
+    using size_type              = typename Rep_type::size_type;
+    using difference_type        = typename Rep_type::difference_type;
+    using reverse_iterator       = typename Rep_type::reverse_iterator;
+    using const_reverse_iterator = typename Rep_type::const_reverse_iterator;
+    using mapped_type            = Value;
+    using key_compare            = Compare;
+    using key_type               = Key;
+    using allocator_type         = Alloc;
+
+    Flat_map() = default;
+
+    explicit Flat_map(const Compare& Comp, const allocator_type& a = allocator_type()) : M_t(Comp, Pair_alloc_type(a)) {}
+
+    explicit Flat_map(const allocator_type& a) : M_t(Pair_alloc_type(a)) {}
+
+    Flat_map(const Flat_map& Right) = default;
+
+    Flat_map(Flat_map&& Right) = default;
+
+    Flat_map(initializer_list<value_type> IList, const Compare& Comp = Compare(), const allocator_type& a = allocator_type())
+     : M_t(Comp, Pair_alloc_type(a)){
+        M_t.M_insert_range_unique(IList.begin(), IList.end());
+    }
+
+    template <class InputIterator>
+    Flat_map(InputIterator First, InputIterator Last, const Compare& Comp = Compare(), const allocator_type& a = allocator_type())
+     : M_t(Comp, Pair_alloc_type(a)) {
+        M_t.M_insert_range_unique(First, Last);
+    }
+
+    // 输入已按键有序且键互不相同：直接拷贝，不再排序
+    template <class InputIterator>
+    Flat_map(sorted_unique_t, InputIterator First, InputIterator Last, const Compare& Comp = Compare(),
+             const allocator_type& a = allocator_type())
+     : M_t(Comp, Pair_alloc_type(a)) {
+        M_t.M_insert_range_sorted_unique(First, Last);
+    }
+
+    Flat_map(sorted_unique_t, initializer_list<value_type> IList, const Compare& Comp = Compare(),
+             const allocator_type& a = allocator_type())
+     : M_t(Comp, Pair_alloc_type(a)) {
+        M_t.M_insert_range_sorted_unique(IList.begin(), IList.end());
+    }
+
+    mapped_type& at(const key_type& key){
+        iterator i = find(key);
+	    if (i == end()){
+	        __throw_out_of_range(__N("Flat_map::at"));
+        }
+	    return (*i).second;
+    }
+
+    const mapped_type& at(const key_type& key) const{
+        const_iterator i = find(key);
+	    if (i == end()){
+	        __throw_out_of_range(__N("Flat_map::at"));
+        }
+	    return (*i).second;
+    }
+
+    iterator begin() noexcept {
+        return M_t.begin();
+    }
+
+    const_iterator begin() const noexcept {
+        return M_t.begin();
+    }
+
+    iterator end() noexcept {
+        return M_t.end();
+    }
+
+    const_iterator end() const noexcept {
+        return M_t.end();
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return M_t.rbegin();
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return M_t.rbegin();
+    }
+
+    reverse_iterator rend() noexcept {
+        return M_t.rend();
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return M_t.rend();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return M_t.begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return M_t.end();
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return M_t.rbegin();
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return M_t.rend();
+    }
+
+    void clear(){
+        M_t.clear();
+    }
+
+    size_type count(const Key& key) const{
+        return M_t.count(key);
+    }
+
+    bool contains(const Key& key) const{
+        return M_t.find(key) != M_t.end();
+    }
+
+    // 顺序统计：按键序第 k 个元素（从 0 开始），越界返回 end()
+    iterator nth(size_type k) noexcept {
+        return M_t.nth(k);
+    }
+
+    const_iterator nth(size_type k) const noexcept {
+        return M_t.nth(k);
+    }
+
+    // 键小于 key 的元素个数
+    size_type rank(const Key& key) const {
+        return M_t.rank(key);
+    }
+
+    difference_type distance(const_iterator first, const_iterator last) const noexcept {
+        return M_t.distance(first, last);
+    }
+
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args){
+        return M_t._M_emplace_unique(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator where, Args&&... args){
+        return M_t._M_emplace_hint_unique(where, std::forward<Args>(args)...);
+    }
+
+    bool empty() const noexcept{
+        return M_t.empty();
+    }
+
+    pair <const_iterator, const_iterator> equal_range (const Key& key) const{
+        return M_t.equal_range(key);
+    }
+
+    pair <iterator, iterator> equal_range (const Key& key){
+        return M_t.equal_range(key);
+    }
+
+    iterator erase(const_iterator Where){
+        return M_t.erase(Where);
+    }
+
+    iterator erase(const_iterator First, const_iterator Last){
+        return M_t.erase(First, Last);
+    }
+
+    size_type erase(const key_type& key){
+        return M_t.erase(key);
+    }
+
+    iterator find(const Key& key){
+        return M_t.find(key);
+    }
+
+    const_iterator find(const Key& key) const{
+        return M_t.find(key);
+    }
+
+    template<typename Kt>
+	auto find(const Kt& x) -> decltype(iterator(M_t.M_find_tr(x))) {
+        return iterator(M_t.M_find_tr(x));
+    }
+
+    template<typename Kt>
+	auto find(const Kt& x) const -> decltype(const_iterator(M_t.M_find_tr(x))) {
+        return const_iterator(M_t.M_find_tr(x));
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(M_t.get_allocator());
+    }
+
+    // (1) single element
+    std::pair<iterator, bool> insert(const value_type& Val) {
+        return M_t._M_insert_unique(Val);
+    }
+
+    // (2) single element, perfect forwarded
+    std::pair<iterator, bool> insert(value_type&& Val){
+        return M_t._M_insert_unique(std::move(Val));
+    }
+
+    // (3) single element with hint
+    iterator insert(const_iterator Where, const value_type& Val){
+        return M_t._M_insert_unique_(Where, Val);
+    }
+
+    // (4) single element, perfect forwarded, with hint
+    iterator insert(const_iterator Where, value_type&& Val){
+        return M_t._M_insert_unique_(Where, std::move(Val));
+    }
+
+    // (5) range：追加后一次排序归并
+    template <class InputIterator>
+    void insert(InputIterator First, InputIterator Last){
+        M_t.M_insert_range_unique(First, Last);
+    }
+
+    // (6) initializer list
+    void insert(initializer_list<value_type> IList){
+        insert(IList.begin(), IList.end());
+    }
+
+    // (7) range，已按键有序且键互不相同
+    template <class InputIterator>
+    void insert(sorted_unique_t, InputIterator First, InputIterator Last){
+        M_t.M_insert_range_sorted_unique(First, Last);
+    }
+
+    key_compare key_comp() const {
+        return M_t.key_comp();
+    }
+
+    iterator lower_bound(const Key& key) {
+        return M_t.lower_bound(key);
+    }
+
+    template<typename Kt>
+	auto lower_bound(const Kt& x) -> decltype(iterator(M_t.M_lower_bound_tr(x))) {
+        return iterator(M_t.M_lower_bound_tr(x));
+    }
+
+    const_iterator lower_bound(const Key& key) const {
+        return M_t.lower_bound(key);
+    }
+
+    template<typename Kt>
+	auto lower_bound(const Kt& x) const -> decltype(const_iterator(M_t.M_lower_bound_tr(x))) {
+        return const_iterator(M_t.M_lower_bound_tr(x));
+    }
+
+    size_type max_size() const {
+        return M_t.max_size();
+    }
+
+    size_type size() const noexcept {
+        return M_t.size();
+    }
+
+    size_type capacity() const noexcept {
+        return M_t.capacity();
+    }
+
+    void reserve(size_type n) {
+        M_t.reserve(n);
+    }
+
+    void shrink_to_fit() {
+        M_t.shrink_to_fit();
+    }
+
+    void swap(Flat_map& right) noexcept(__is_nothrow_swappable<Compare>::value) {
+        M_t.swap(right.M_t);
+    }
+
+    iterator upper_bound(const Key& key){
+        return M_t.upper_bound(key);
+    }
+
+    const_iterator upper_bound(const Key& key) const {
+        return M_t.upper_bound(key);
+    }
+
+    value_compare value_comp() const {
+        return value_compare(M_t.key_comp());
+    }
+
+    mapped_type& operator[](const Key& key){
+        __glibcxx_function_requires(_DefaultConstructibleConcept<mapped_type>)
+
+	    iterator i = lower_bound(key);
+	    // i->first is greater than or equivalent to key.
+	    if (i == end() || key_comp()(key, (*i).first))
+	        i = M_t._M_emplace_hint_unique(i, std::piecewise_construct, std::tuple<const key_type&>(key),
+					                        std::tuple<>());
+	    return (*i).second;
+    }
+
+    mapped_type& operator[](Key&& key){
+        __glibcxx_function_requires(_DefaultConstructibleConcept<mapped_type>)
+        iterator i = lower_bound(key);
+        // i->first is greater than or equivalent to key.
+        if (i == end() || key_comp()(key, (*i).first))
+            i = M_t._M_emplace_hint_unique(i, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                            std::tuple<>());
+        return (*i).second;
+    }
+
+    Flat_map& operator=(const Flat_map&) = default;
+
+    Flat_map& operator=(Flat_map&&) = default;
+
+    Flat_map& operator=(initializer_list<value_type> l) {
+	    M_t.M_assign_unique(l.begin(), l.end());
+	    return *this;
+    }
+
+    friend bool operator==(const Flat_map& x, const Flat_map& y) {
+        return x.M_t == y.M_t;
+    }
+
+    friend bool operator!=(const Flat_map& x, const Flat_map& y) {
+        return !(x == y);
+    }
+
+    friend bool operator<(const Flat_map& x, const Flat_map& y) {
+        return x.M_t < y.M_t;
+    }
+
+};
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+inline void swap(Flat_map<Key, Value, Compare, Alloc>& x, Flat_map<Key, Value, Compare, Alloc>& y) {
+    x.swap(y);
+}
+
+#endif // FLAT_MAP_H
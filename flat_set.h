@@ -0,0 +1,327 @@
+#ifndef FLAT_SET_H
+#define FLAT_SET_H
+
+#include <initializer_list>
+#include "flat_tree.h"
+
+// 有序 Vector 存放的集合，接口与 Set 一致。
+// 每个元素只占 sizeof(Key)，没有红黑树节点的三个指针与颜色；
+// 插入、删除使迭代器和引用失效，适合构建一次、反复查询的表。
+// 批量数据请用区间 insert / 区间构造：先追加再一次排序归并，比逐个插入少 O(n) 倍的搬移
+template<typename Key, typename Compare = std::less<Key>, typename Alloc = Allocator<Key>>
+class Flat_set{
+
+      static_assert(is_same<typename remove_cv<Key>::type, Key>::value,
+	  "Flat_set must have a non-const, non-volatile value_type");
+
+public:
+    using key_type       = Key;
+    using value_type     = Key;
+    using key_compare    = Compare;
+    using value_compare  = Compare;
+    using allocator_type = Alloc;
+
+private:
+    using Key_alloc_type = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Key>::other;
+
+    using Rep_type = Flat_tree<key_type, value_type, _Identity<value_type>, key_compare, Key_alloc_type>;
+
+    Rep_type M_t;
+
+public:
+    using pointer                = typename Rep_type::const_pointer;
+    using const_pointer          = typename Rep_type::const_pointer;
+    using reference              = typename Rep_type::const_reference;
+    using const_reference        = typename Rep_type::const_reference;
+    using iterator               = typename Rep_type::const_iterator;
+    using const_iterator         = typename Rep_type::const_iterator;
+    using reverse_iterator       = typename Rep_type::const_reverse_iterator;
+    using const_reverse_iterator = typename Rep_type::const_reverse_iterator;
+    using size_type              = typename Rep_type::size_type;
+    using difference_type        = typename Rep_type::difference_type;
+
+    Flat_set() = default;
+
+    explicit Flat_set(const Compare& comp, const allocator_type& a = allocator_type()) : M_t(comp, Key_alloc_type(a)) {}
+
+    explicit Flat_set(const allocator_type& a) : M_t(Key_alloc_type(a)) {}
+
+    template<typename InputIterator>
+	Flat_set(InputIterator first, InputIterator last, const Compare& comp = Compare(),
+             const allocator_type& a = allocator_type())
+	    : M_t(comp, Key_alloc_type(a)) {
+            M_t.M_insert_range_unique(first, last);
+    }
+
+    // 输入已按键有序且互不相同：直接拷贝，不再排序
+    template<typename InputIterator>
+	Flat_set(sorted_unique_t, InputIterator first, InputIterator last, const Compare& comp = Compare(),
+	         const allocator_type& a = allocator_type())
+	    : M_t(comp, Key_alloc_type(a)) {
+            M_t.M_insert_range_sorted_unique(first, last);
+    }
+
+    Flat_set(sorted_unique_t, initializer_list<value_type> l, const Compare& comp = Compare(),
+             const allocator_type& a = allocator_type())
+      : M_t(comp, Key_alloc_type(a)) {
+        M_t.M_insert_range_sorted_unique(l.begin(), l.end());
+    }
+
+    Flat_set(initializer_list<value_type> l, const Compare& comp = Compare(), const allocator_type& a = allocator_type())
+      : M_t(comp, Key_alloc_type(a)) {
+        M_t.M_insert_range_unique(l.begin(), l.end());
+    }
+
+    Flat_set(const Flat_set&) = default;
+
+    Flat_set(Flat_set&&) = default;
+
+    ~Flat_set() = default;
+
+    Flat_set& operator=(const Flat_set&) = default;
+
+    Flat_set& operator=(Flat_set&&) = default;
+
+    Flat_set& operator=(initializer_list<value_type> l) {
+	    M_t.M_assign_unique(l.begin(), l.end());
+	    return *this;
+    }
+
+    key_compare key_comp() const {
+        return M_t.key_comp();
+    }
+
+    value_compare value_comp() const {
+        return M_t.key_comp();
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(M_t.get_allocator());
+    }
+
+    iterator begin() const noexcept {
+        return M_t.begin();
+    }
+
+    iterator end() const noexcept {
+        return M_t.end();
+    }
+
+    reverse_iterator rbegin() const noexcept {
+        return M_t.rbegin();
+    }
+
+    reverse_iterator rend() const noexcept {
+        return M_t.rend();
+    }
+
+    iterator cbegin() const noexcept {
+        return M_t.begin();
+    }
+
+    iterator cend() const noexcept {
+        return M_t.end();
+    }
+
+    reverse_iterator crbegin() const noexcept {
+        return M_t.rbegin();
+    }
+
+    reverse_iterator crend() const noexcept {
+        return M_t.rend();
+    }
+
+    bool empty() const noexcept {
+        return M_t.empty();
+    }
+
+    size_type size() const noexcept {
+        return M_t.size();
+    }
+
+    size_type max_size() const noexcept {
+        return M_t.max_size();
+    }
+
+    size_type capacity() const noexcept {
+        return M_t.capacity();
+    }
+
+    void reserve(size_type n) {
+        M_t.reserve(n);
+    }
+
+    void shrink_to_fit() {
+        M_t.shrink_to_fit();
+    }
+
+    void swap(Flat_set& x) noexcept(__is_nothrow_swappable<Compare>::value) {
+        M_t.swap(x.M_t);
+    }
+
+    template<typename... Args>
+	std::pair<iterator, bool> emplace(Args&&... args) {
+        return M_t._M_emplace_unique(std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+	iterator emplace_hint(const_iterator pos, Args&&... args) {
+	    return M_t._M_emplace_hint_unique(pos, std::forward<Args>(args)...);
+	}
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+	    std::pair<typename Rep_type::iterator, bool> p = M_t._M_insert_unique(x);
+	    return std::pair<iterator, bool>(p.first, p.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& x) {
+	    std::pair<typename Rep_type::iterator, bool> p = M_t._M_insert_unique(std::move(x));
+	    return std::pair<iterator, bool>(p.first, p.second);
+    }
+
+    iterator insert(const_iterator position, const value_type& x) {
+        return M_t._M_insert_unique_(position, x);
+    }
+
+    iterator insert(const_iterator position, value_type&& x) {
+        return M_t._M_insert_unique_(position, std::move(x));
+    }
+
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        M_t.M_insert_range_unique(first, last);
+    }
+
+    // 区间已按键有序且互不相同
+    template<typename InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last) {
+        M_t.M_insert_range_sorted_unique(first, last);
+    }
+
+    void insert(initializer_list<value_type> l) {
+        this->insert(l.begin(), l.end());
+    }
+
+    iterator erase(const_iterator position) {
+        return M_t.erase(position);
+    }
+
+    size_type erase(const key_type& x) {
+        return M_t.erase(x);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        return M_t.erase(first, last);
+    }
+
+    void clear() noexcept {
+        M_t.clear();
+    }
+
+    size_type count(const key_type& x) const {
+        return M_t.count(x);
+    }
+
+    template<typename Kt>
+	auto count(const Kt& x) const->decltype(M_t.M_count_tr(x)) {
+        return M_t.M_count_tr(x);
+    }
+
+    bool contains(const key_type& x) const {
+        return M_t.find(x) != M_t.end();
+    }
+
+    // 顺序统计：第 k 小的元素（从 0 开始），越界返回 end()
+    iterator nth(size_type k) const noexcept {
+        return M_t.nth(k);
+    }
+
+    // 小于 x 的元素个数
+    size_type rank(const key_type& x) const {
+        return M_t.rank(x);
+    }
+
+    difference_type distance(const_iterator first, const_iterator last) const noexcept {
+        return M_t.distance(first, last);
+    }
+
+    const_iterator find(const key_type& x) const {
+        return M_t.find(x);
+    }
+
+    template<typename Kt>
+	auto find(const Kt& x) const->decltype(const_iterator{M_t.M_find_tr(x)}) {
+        return const_iterator{M_t.M_find_tr(x)};
+    }
+
+    const_iterator lower_bound(const key_type& x) const {
+        return M_t.lower_bound(x);
+    }
+
+    template<typename Kt>
+	auto lower_bound(const Kt& x) const->decltype(const_iterator(M_t.M_lower_bound_tr(x))) {
+        return const_iterator(M_t.M_lower_bound_tr(x));
+    }
+
+    const_iterator upper_bound(const key_type& x) const {
+        return M_t.upper_bound(x);
+    }
+
+    template<typename Kt>
+	auto upper_bound(const Kt& x) const->decltype(const_iterator(M_t.M_upper_bound_tr(x))) {
+        return const_iterator(M_t.M_upper_bound_tr(x));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& x) const {
+        return M_t.equal_range(x);
+    }
+
+    template<typename Kt>
+	auto equal_range(const Kt& x) const->decltype(pair<const_iterator, const_iterator>(M_t.M_equal_range_tr(x))) {
+        return pair<const_iterator, const_iterator>(M_t.M_equal_range_tr(x));
+    }
+
+    template<typename K1, typename C1, typename A1>
+	friend bool operator==(const Flat_set<K1, C1, A1>&, const Flat_set<K1, C1, A1>&);
+
+    template<typename K1, typename C1, typename A1>
+	friend bool operator<(const Flat_set<K1, C1, A1>&, const Flat_set<K1, C1, A1>&);
+
+};
+
+template<typename Key, typename Compare, typename Alloc>
+inline bool operator==(const Flat_set<Key, Compare, Alloc>& x, const Flat_set<Key, Compare, Alloc>& y) {
+    return x.M_t == y.M_t;
+}
+
+template<typename Key, typename Compare, typename Alloc>
+inline bool operator<(const Flat_set<Key, Compare, Alloc>& x, const Flat_set<Key, Compare, Alloc>& y) {
+    return x.M_t < y.M_t;
+}
+
+template<typename Key, typename Compare, typename Alloc>
+inline bool operator!=(const Flat_set<Key, Compare, Alloc>& x, const Flat_set<Key, Compare, Alloc>& y) {
+    return !(x == y);
+}
+
+template<typename Key, typename Compare, typename Alloc>
+inline bool operator>(const Flat_set<Key, Compare, Alloc>& x, const Flat_set<Key, Compare, Alloc>& y) {
+    return y < x;
+}
+
+template<typename Key, typename Compare, typename Alloc>
+inline bool operator<=(const Flat_set<Key, Compare, Alloc>& x, const Flat_set<Key, Compare, Alloc>& y) {
+    return !(y < x);
+}
+
+template<typename Key, typename Compare, typename Alloc>
+inline bool operator>=(const Flat_set<Key, Compare, Alloc>& x, const Flat_set<Key, Compare, Alloc>& y) {
+    return !(x < y);
+}
+
+template<typename Key, typename Compare, typename Alloc>
+inline void swap(Flat_set<Key, Compare, Alloc>& x, Flat_set<Key, Compare, Alloc>& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+}
+
+#endif // FLAT_SET_H
@@ -0,0 +1,436 @@
+#ifndef FLAT_TREE_H
+#define FLAT_TREE_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "vector.h"
+#include "rb_tree.h"
+#include "btree.h"
+
+// 有序 Vector 上的唯一键关联容器，Flat_map / Flat_set 的底层实现。
+// 元素连续存放，没有逐节点的指针与分配，遍历是顺序访存；适合读多写少的场景：
+// 查找为无分支二分，单个插入、删除需要搬移 O(n) 个元素，批量插入先追加再一次排序归并。
+// 插入、删除都会使迭代器和引用失效。
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc = Allocator<Val>>
+class Flat_tree{
+
+    using Val_alloc_type = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Val>::other;
+    using Container      = Vector<Val, Val_alloc_type>;
+
+    // 元素就是键的整数 + less / greater：二分缩到一小段后用 SIMD 一次比较整段
+    static constexpr bool S_simd_keys = is_same_v<Key, Val> && is_integral_v<Key> && !is_same_v<Key, bool> &&
+                                        (sizeof(Key) == 4 || sizeof(Key) == 8) &&
+                                        (is_same_v<Compare, std::less<Key>> || is_same_v<Compare, std::less<>> ||
+                                         is_same_v<Compare, std::greater<Key>> || is_same_v<Compare, std::greater<>>);
+    static constexpr bool S_greater_compare = is_same_v<Compare, std::greater<Key>> || is_same_v<Compare, std::greater<>>;
+    static constexpr size_t S_simd_window   = 64;
+
+public:
+    using key_type               = Key;
+    using value_type             = Val;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = size_t;
+    using difference_type        = std::ptrdiff_t;
+    using allocator_type         = Alloc;
+    using iterator               = typename Container::iterator;
+    using const_iterator         = typename Container::const_iterator;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    Container M_data;
+    Compare   M_key_compare;
+
+    template<typename, typename, typename, typename, typename>
+    friend class Flat_tree;
+
+    static const Key& S_key(const Val& v) {
+        return KeyOfValue()(v);
+    }
+
+    bool M_value_less(const Val& x, const Val& y) const {
+        return M_key_compare(S_key(x), S_key(y));
+    }
+
+    // lower_bound（Upper 为 true 时 upper_bound）的下标
+    template<bool Upper, typename Kt>
+    size_t M_bound(const Kt& k) const {
+        const Val* a = M_data.data();
+        size_t lo = 0, len = M_data.size();
+        // 无分支二分：每轮只根据一次比较调整区间
+        auto step = [&] {
+            size_t half = len >> 1;
+            bool right = Upper ? !M_key_compare(k, S_key(a[lo + half]))
+                               : M_key_compare(S_key(a[lo + half]), k);
+            lo  = right ? lo + half + 1 : lo;
+            len = right ? len - half - 1 : half;
+        };
+        if constexpr (S_simd_keys && is_same_v<Kt, Key>) {
+            while (len > S_simd_window)
+                step();
+            if constexpr (S_greater_compare)
+                return lo + (Upper ? len - Btree_search::S_count<false>(a + lo, len, k)
+                                   : Btree_search::S_count<true>(a + lo, len, k));
+            else
+                return lo + (Upper ? len - Btree_search::S_count<true>(a + lo, len, k)
+                                   : Btree_search::S_count<false>(a + lo, len, k));
+        }
+        else {
+            while (len > 0)
+                step();
+            return lo;
+        }
+    }
+
+    template<typename Kt>
+    size_t M_find_index(const Kt& k) const {
+        size_t i = M_bound<false>(k);
+        if (i == M_data.size() || M_key_compare(k, S_key(M_data[i])))
+            return M_data.size();
+        return i;
+    }
+
+    template<typename Kt>
+    std::pair<size_t, size_t> M_equal_range_index(const Kt& k) const {
+        return { M_bound<false>(k), M_bound<true>(k) };
+    }
+
+    iterator M_iter(size_t i) noexcept {
+        return M_data.begin() + i;
+    }
+
+    const_iterator M_iter(size_t i) const noexcept {
+        return M_data.begin() + i;
+    }
+
+    // 键 k 的插入下标；second 为 false 表示键已存在，first 即该元素
+    std::pair<size_t, bool> M_get_insert_unique_pos(const Key& k) const {
+        size_t i = M_bound<false>(k);
+        return { i, i == M_data.size() || M_key_compare(k, S_key(M_data[i])) };
+    }
+
+    // hint 前后的元素恰好夹住 k 时直接使用 hint，否则重新二分
+    std::pair<size_t, bool> M_get_insert_hint_unique_pos(const_iterator hint, const Key& k) const {
+        size_t i = hint - M_data.begin();
+        bool before = i == M_data.size() || M_key_compare(k, S_key(M_data[i]));
+        bool after  = i == 0 || M_key_compare(S_key(M_data[i - 1]), k);
+        if (before && after)
+            return { i, true };
+        return M_get_insert_unique_pos(k);
+    }
+
+    // 批量插入：新元素先追加到末尾，排序去重后与原有部分一次归并。
+    // Sorted 为 true 时调用者保证输入已按键有序且互不相同。键重复时保留先出现的元素
+    template<bool Sorted, typename InputIterator>
+    void M_insert_range(InputIterator first, InputIterator last) {
+        size_t n0 = M_data.size();
+        using Category = typename iterator_traits<InputIterator>::iterator_category;
+        if constexpr (is_base_of_v<forward_iterator_tag, Category>)
+            M_data.reserve(n0 + std::distance(first, last));
+        try {
+            for (; first != last; ++first)
+                M_data.emplace_back(*first);
+        }
+        catch (...) {
+            M_data.erase(M_data.begin() + n0, M_data.end());
+            throw;
+        }
+
+        auto less  = [this](const Val& x, const Val& y) { return M_value_less(x, y); };
+        auto equiv = [this](const Val& x, const Val& y) { return !M_value_less(x, y); };
+        Val* base = M_data.data();
+        Val* mid  = base + n0;
+        Val* end  = base + M_data.size();
+        if (mid == end)
+            return;
+        if (!Sorted) {
+            std::stable_sort(mid, end, less);
+            end = std::unique(mid, end, equiv);
+        }
+        // 新元素整体排在原有元素之后（顺序追加）时不用归并
+        if (mid != base && !M_value_less(mid[-1], *mid)) {
+            std::inplace_merge(base, mid, end, less);
+            end = std::unique(base, end, equiv);
+        }
+        M_data.erase(end, M_data.end());
+    }
+
+public:
+    Flat_tree() = default;
+
+    Flat_tree(const Compare& comp, const allocator_type& a = allocator_type())
+        : M_data(Val_alloc_type(a)), M_key_compare(comp) {}
+
+    Flat_tree(const allocator_type& a) : M_data(Val_alloc_type(a)), M_key_compare() {}
+
+    Flat_tree(const Flat_tree&) = default;
+
+    Flat_tree(Flat_tree&&) = default;
+
+    ~Flat_tree() = default;
+
+    Flat_tree& operator=(const Flat_tree&) = default;
+
+    Flat_tree& operator=(Flat_tree&&) = default;
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(M_data.get_allocator());
+    }
+
+    Compare key_comp() const {
+        return M_key_compare;
+    }
+
+    iterator begin() noexcept {
+        return M_data.begin();
+    }
+
+    const_iterator begin() const noexcept {
+        return M_data.begin();
+    }
+
+    iterator end() noexcept {
+        return M_data.end();
+    }
+
+    const_iterator end() const noexcept {
+        return M_data.end();
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    bool empty() const noexcept {
+        return M_data.empty();
+    }
+
+    size_type size() const noexcept {
+        return M_data.size();
+    }
+
+    size_type max_size() const noexcept {
+        return size_type(-1) / sizeof(Val);
+    }
+
+    size_type capacity() const noexcept {
+        return M_data.capacity();
+    }
+
+    void reserve(size_type n) {
+        M_data.reserve(n);
+    }
+
+    void shrink_to_fit() {
+        M_data.shrink_to_fit();
+    }
+
+    void clear() noexcept {
+        M_data.clear();
+    }
+
+    void swap(Flat_tree& x) noexcept(__is_nothrow_swappable<Compare>::value) {
+        M_data.swap(x.M_data);
+        std::swap(M_key_compare, x.M_key_compare);
+    }
+
+    template<typename Arg>
+    std::pair<iterator, bool> _M_insert_unique(Arg&& v) {
+        std::pair<size_t, bool> res = M_get_insert_unique_pos(S_key(v));
+        if (!res.second)
+            return { M_iter(res.first), false };
+        return { M_data.emplace(M_iter(res.first), std::forward<Arg>(v)), true };
+    }
+
+    template<typename Arg>
+    iterator _M_insert_unique_(const_iterator hint, Arg&& v) {
+        std::pair<size_t, bool> res = M_get_insert_hint_unique_pos(hint, S_key(v));
+        if (!res.second)
+            return M_iter(res.first);
+        return M_data.emplace(M_iter(res.first), std::forward<Arg>(v));
+    }
+
+    // 没有节点可以先构造：在栈上构造出元素，确定位置后再移入
+    template<typename... Args>
+    std::pair<iterator, bool> _M_emplace_unique(Args&&... args) {
+        Val v(std::forward<Args>(args)...);
+        return _M_insert_unique(std::move(v));
+    }
+
+    template<typename... Args>
+    iterator _M_emplace_hint_unique(const_iterator hint, Args&&... args) {
+        Val v(std::forward<Args>(args)...);
+        return _M_insert_unique_(hint, std::move(v));
+    }
+
+    template<typename InputIterator>
+    void M_insert_range_unique(InputIterator first, InputIterator last) {
+        M_insert_range<false>(first, last);
+    }
+
+    // 调用者保证 [first, last) 已按键有序且互不相同
+    template<typename InputIterator>
+    void M_insert_range_sorted_unique(InputIterator first, InputIterator last) {
+        M_insert_range<true>(first, last);
+    }
+
+    template<typename InputIterator>
+    void M_assign_unique(InputIterator first, InputIterator last) {
+        M_data.clear();
+        M_insert_range<false>(first, last);
+    }
+
+    iterator erase(const_iterator pos) {
+        return M_data.erase(pos);
+    }
+
+    iterator erase(iterator pos) {
+        return M_data.erase(pos);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        return M_data.erase(first, last);
+    }
+
+    size_type erase(const Key& k) {
+        std::pair<size_t, size_t> r = M_equal_range_index(k);
+        M_data.erase(M_iter(r.first), M_iter(r.second));
+        return r.second - r.first;
+    }
+
+    iterator find(const Key& k) {
+        return M_iter(M_find_index(k));
+    }
+
+    const_iterator find(const Key& k) const {
+        return M_iter(M_find_index(k));
+    }
+
+    size_type count(const Key& k) const {
+        return M_find_index(k) == M_data.size() ? 0 : 1;
+    }
+
+    iterator lower_bound(const Key& k) {
+        return M_iter(M_bound<false>(k));
+    }
+
+    const_iterator lower_bound(const Key& k) const {
+        return M_iter(M_bound<false>(k));
+    }
+
+    iterator upper_bound(const Key& k) {
+        return M_iter(M_bound<true>(k));
+    }
+
+    const_iterator upper_bound(const Key& k) const {
+        return M_iter(M_bound<true>(k));
+    }
+
+    std::pair<iterator, iterator> equal_range(const Key& k) {
+        std::pair<size_t, size_t> r = M_equal_range_index(k);
+        return { M_iter(r.first), M_iter(r.second) };
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& k) const {
+        std::pair<size_t, size_t> r = M_equal_range_index(k);
+        return { M_iter(r.first), M_iter(r.second) };
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    iterator M_find_tr(const Kt& k) {
+        return M_iter(M_find_index(k));
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    const_iterator M_find_tr(const Kt& k) const {
+        return M_iter(M_find_index(k));
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    size_type M_count_tr(const Kt& k) const {
+        std::pair<size_t, size_t> r = M_equal_range_index(k);
+        return r.second - r.first;
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    iterator M_lower_bound_tr(const Kt& k) {
+        return M_iter(M_bound<false>(k));
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    const_iterator M_lower_bound_tr(const Kt& k) const {
+        return M_iter(M_bound<false>(k));
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    iterator M_upper_bound_tr(const Kt& k) {
+        return M_iter(M_bound<true>(k));
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    const_iterator M_upper_bound_tr(const Kt& k) const {
+        return M_iter(M_bound<true>(k));
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    std::pair<iterator, iterator> M_equal_range_tr(const Kt& k) {
+        std::pair<size_t, size_t> r = M_equal_range_index(k);
+        return { M_iter(r.first), M_iter(r.second) };
+    }
+
+    template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
+    std::pair<const_iterator, const_iterator> M_equal_range_tr(const Kt& k) const {
+        std::pair<size_t, size_t> r = M_equal_range_index(k);
+        return { M_iter(r.first), M_iter(r.second) };
+    }
+
+    // 顺序统计在连续存储上是 O(1) / O(log n)
+    iterator nth(size_type k) noexcept {
+        return k < M_data.size() ? M_iter(k) : end();
+    }
+
+    const_iterator nth(size_type k) const noexcept {
+        return k < M_data.size() ? M_iter(k) : end();
+    }
+
+    size_type rank(const Key& k) const {
+        return M_bound<false>(k);
+    }
+
+    difference_type distance(const_iterator first, const_iterator last) const noexcept {
+        return last - first;
+    }
+
+    friend bool operator==(const Flat_tree& x, const Flat_tree& y) {
+        return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+    }
+
+    friend bool operator<(const Flat_tree& x, const Flat_tree& y) {
+        return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    }
+};
+
+template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+inline void swap(Flat_tree<Key, Val, KeyOfValue, Compare, Alloc>& x, Flat_tree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+    x.swap(y);
+}
+
+#endif // FLAT_TREE_H
@@ -0,0 +1,57 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <algorithm>
+#include <cstddef>
+
+// Vector / Basic_string 的扩容策略（模板参数）。
+// S_grow(capacity, required, elem_size) 返回新的容量（元素个数），保证不小于 required；
+// required 是本次操作结束后需要的元素个数，批量插入时一次算好，不会在一次调用里反复扩容
+
+// 两倍增长：重新分配次数最少，最多浪费一半空间
+struct Growth_double{
+    static constexpr size_t S_grow(size_t capacity, size_t required, size_t) noexcept {
+        return std::max({ capacity * 2, required, size_t(1) });
+    }
+};
+
+// 1.5 倍增长：空间浪费更少，释放的旧块有机会被后续分配复用
+struct Growth_one_and_half{
+    static constexpr size_t S_grow(size_t capacity, size_t required, size_t) noexcept {
+        return std::max({ capacity + capacity / 2, required, size_t(1) });
+    }
+};
+
+// 固定步长：容量按 Step 个元素取整，适合大小可预期、不希望预留过多的场景
+template<size_t Step>
+struct Growth_fixed_step{
+    static_assert(Step > 0, "growth step must be positive");
+
+    static constexpr size_t S_grow(size_t capacity, size_t required, size_t) noexcept {
+        size_t want = std::max(capacity + Step, required);
+        return (want + Step - 1) / Step * Step;
+    }
+};
+
+// 按 jemalloc 的大小类取整：1.5 倍增长后把字节数向上取到分配器实际会给的块大小，
+// 多出来的字节直接算作容量，不会白白浪费在分配器内部
+struct Growth_size_class{
+    // 不小于 bytes 的最小大小类：16 字节以内按 8/16，128 字节以内按 16 字节步长，
+    // 之后每个 2 的幂区间 (2^k, 2^(k+1)] 分成 4 档
+    static constexpr size_t S_size_class(size_t bytes) noexcept {
+        if (bytes <= 8)
+            return 8;
+        if (bytes <= 128)
+            return (bytes + 15) & ~size_t(15);
+        size_t k = 63 - __builtin_clzll(static_cast<unsigned long long>(bytes - 1));
+        size_t spacing = size_t(1) << (k - 2);
+        return (bytes + spacing - 1) & ~(spacing - 1);
+    }
+
+    static constexpr size_t S_grow(size_t capacity, size_t required, size_t elem_size) noexcept {
+        size_t want = std::max({ capacity + capacity / 2, required, size_t(1) });
+        return S_size_class(want * elem_size) / elem_size;
+    }
+};
+
+#endif // GROWTH_POLICY_H
@@ -0,0 +1,801 @@
+#ifndef HASHTABLE_H
+#define HASHTABLE_H
+
+#include <ext/aligned_buffer.h>    // 内存对齐的缓冲区
+#include <ext/alloc_traits.h>      // 分配器特性
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "rb_tree.h"               // Node_handle / Node_insert_return
+#include "allocator.h"
+
+// 控制字节：满槽存放哈希值的低 7 位（0~127），其余为特殊标记
+using Hashtable_ctrl = signed char;
+
+enum : Hashtable_ctrl {
+    S_ctrl_empty    = -128,   // 空槽
+    S_ctrl_deleted  = -2,     // 墓碑
+    S_ctrl_sentinel = -1      // 控制数组末尾的哨兵，迭代到此停止
+};
+
+// 一组 16 个控制字节，SSE2 下一条指令完成整组比较，否则逐字节比较
+struct Hashtable_group{
+    static constexpr size_t S_width = 16;
+
+#if defined(__SSE2__)
+    explicit Hashtable_group(const Hashtable_ctrl* p)
+        : M_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+    // 与 h2 相等的槽位掩码
+    uint32_t M_match(Hashtable_ctrl h2) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), M_ctrl)));
+    }
+
+    uint32_t M_match_empty() const {
+        return M_match(S_ctrl_empty);
+    }
+
+    // 空槽与墓碑都小于哨兵
+    uint32_t M_match_empty_or_deleted() const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(S_ctrl_sentinel), M_ctrl)));
+    }
+
+    __m128i M_ctrl;
+#else
+    explicit Hashtable_group(const Hashtable_ctrl* p) {
+        std::memcpy(M_ctrl, p, S_width);
+    }
+
+    uint32_t M_match(Hashtable_ctrl h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < S_width; ++i) {
+            mask |= uint32_t(M_ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    uint32_t M_match_empty() const {
+        return M_match(S_ctrl_empty);
+    }
+
+    uint32_t M_match_empty_or_deleted() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < S_width; ++i) {
+            mask |= uint32_t(M_ctrl[i] < S_ctrl_sentinel) << i;
+        }
+        return mask;
+    }
+
+    Hashtable_ctrl M_ctrl[S_width];
+#endif
+
+    static unsigned S_trailing_zeros(uint32_t mask) noexcept {
+        return mask ? __builtin_ctz(mask) : S_width;
+    }
+
+    static unsigned S_leading_zeros(uint32_t mask) noexcept {
+        return mask ? __builtin_clz(mask) - (32 - S_width) : S_width;
+    }
+};
+
+// 三角探测序列，每次跳过一整组；容量为 2^k-1 时可以遍历所有组
+struct Hashtable_probe_seq{
+    Hashtable_probe_seq(size_t h1, size_t mask) : M_mask(mask), M_offset(h1 & mask) {}
+
+    size_t M_offset_of(size_t i) const {
+        return (M_offset + i) & M_mask;
+    }
+
+    void M_next() {
+        M_index += Hashtable_group::S_width;
+        M_offset = (M_offset + M_index) & M_mask;
+    }
+
+    size_t M_mask;
+    size_t M_offset;
+    size_t M_index = 0;
+};
+
+// extract() 返回的节点：开放寻址的槽位不能脱离表存在，提取时把值移动到单独分配的节点中
+template<typename Val>
+struct Hashtable_node{
+    __gnu_cxx::__aligned_membuf<Val> M_storage;
+
+    Val* M_valptr(){
+        return M_storage._M_ptr();
+    }
+
+    const Val* M_valptr() const {
+        return M_storage._M_ptr();
+    }
+};
+
+// 哈希表迭代器（前向迭代器），跳过空槽与墓碑
+template<typename Val, bool IsConst>
+class Hashtable_iterator{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Val;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::conditional_t<IsConst, const Val*, Val*>;
+    using reference         = std::conditional_t<IsConst, const Val&, Val&>;
+
+    Hashtable_iterator() noexcept : M_ctrl(nullptr), M_slot(nullptr) {}
+
+    Hashtable_iterator(const Hashtable_ctrl* ctrl, Val* slot) noexcept : M_ctrl(ctrl), M_slot(slot) {
+        M_skip_empty_or_deleted();
+    }
+
+    // 非 const 迭代器到 const 迭代器的转换
+    template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Hashtable_iterator(const Hashtable_iterator<Val, OtherConst>& other) noexcept
+        : M_ctrl(other.M_ctrl), M_slot(other.M_slot) {}
+
+    reference operator*() const noexcept {
+        return *M_slot;
+    }
+
+    pointer operator->() const noexcept {
+        return M_slot;
+    }
+
+    Hashtable_iterator& operator++() noexcept {
+        ++M_ctrl;
+        ++M_slot;
+        M_skip_empty_or_deleted();
+        return *this;
+    }
+
+    Hashtable_iterator operator++(int) noexcept {
+        Hashtable_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    friend bool operator==(const Hashtable_iterator& x, const Hashtable_iterator& y) noexcept {
+        return x.M_ctrl == y.M_ctrl;
+    }
+
+    friend bool operator!=(const Hashtable_iterator& x, const Hashtable_iterator& y) noexcept {
+        return x.M_ctrl != y.M_ctrl;
+    }
+
+private:
+    template<typename, bool>
+    friend class Hashtable_iterator;
+
+    template<typename, typename, typename, typename, typename, typename>
+    friend class Hashtable;
+
+    // 空槽与墓碑都小于哨兵，遇到满槽或哨兵时停下
+    void M_skip_empty_or_deleted() noexcept {
+        while (*M_ctrl < S_ctrl_sentinel) {
+            ++M_ctrl;
+            ++M_slot;
+        }
+    }
+
+    const Hashtable_ctrl* M_ctrl;
+    Val*                  M_slot;
+};
+
+// 开放寻址哈希表（Swiss table 布局）：
+// 控制字节数组 M_ctrl 与槽位数组 M_slots 一一对应，容量为 2^k-1，
+// M_ctrl[capacity] 为哨兵，其后复制前 15 个控制字节，保证任意位置都能整组读取。
+template<typename Key, typename Val, typename Alloc, typename ExtractKey, typename Equal, typename Hash>
+class Hashtable{
+
+    using Val_allocator  = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Val>::other;
+    using Ctrl_allocator = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Hashtable_ctrl>::other;
+    using Node_allocator = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Hashtable_node<Val>>::other;
+    using Alloc_traits   = __gnu_cxx::__alloc_traits<Val_allocator>;
+    using Ctrl_traits    = __gnu_cxx::__alloc_traits<Ctrl_allocator>;
+    using Node_traits    = __gnu_cxx::__alloc_traits<Node_allocator>;
+    using Group          = Hashtable_group;
+
+    static constexpr size_t S_width = Group::S_width;
+    static constexpr size_t S_min_capacity = S_width - 1;
+
+public:
+    using key_type           = Key;
+    using value_type         = Val;
+    using pointer            = value_type*;
+    using const_pointer      = const value_type*;
+    using reference          = value_type&;
+    using const_reference    = const value_type&;
+    using size_type          = size_t;
+    using difference_type    = std::ptrdiff_t;
+    using hasher             = Hash;
+    using key_equal          = Equal;
+    using allocator_type     = Alloc;
+    using iterator           = Hashtable_iterator<Val, false>;
+    using const_iterator     = Hashtable_iterator<Val, true>;
+    using node_type          = Node_handle<Key, Val, Node_allocator>;
+    using insert_return_type = Node_insert_return<__conditional_t<is_same_v<Key, Val>, const_iterator, iterator>,
+                                                  node_type>;
+
+private:
+    Hashtable_ctrl* M_ctrl        = S_empty_group();
+    Val*            M_slots       = nullptr;
+    size_t          M_size        = 0;
+    size_t          M_capacity    = 0;
+    size_t          M_growth_left = 0;
+    Hash            M_hash;
+    Equal           M_eq;
+    Val_allocator   M_alloc;
+
+    template<typename, typename, typename, typename, typename, typename>
+    friend class Hashtable;
+
+    // 空表共用的静态控制组：第一个字节为哨兵，查找时总能遇到空槽而停止
+    static Hashtable_ctrl* S_empty_group() noexcept {
+        alignas(16) static Hashtable_ctrl group[S_width] = {
+            S_ctrl_sentinel, S_ctrl_empty, S_ctrl_empty, S_ctrl_empty,
+            S_ctrl_empty,    S_ctrl_empty, S_ctrl_empty, S_ctrl_empty,
+            S_ctrl_empty,    S_ctrl_empty, S_ctrl_empty, S_ctrl_empty,
+            S_ctrl_empty,    S_ctrl_empty, S_ctrl_empty, S_ctrl_empty };
+        return group;
+    }
+
+    // 对用户哈希值再做一次混合，避免 std::hash<int> 这类恒等哈希导致 h2 分布过差
+    size_t M_hash_of(const key_type& k) const {
+        uint64_t h = static_cast<uint64_t>(M_hash(k));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+
+    static size_t S_h1(size_t hash) noexcept {
+        return hash >> 7;
+    }
+
+    static Hashtable_ctrl S_h2(size_t hash) noexcept {
+        return static_cast<Hashtable_ctrl>(hash & 0x7f);
+    }
+
+    static const Key& S_key(const Val& v) {
+        return ExtractKey()(v);
+    }
+
+    // 最大装载因子 7/8
+    static size_t S_capacity_to_growth(size_t capacity) noexcept {
+        return capacity - capacity / 8;
+    }
+
+    static size_t S_growth_to_lower_bound_capacity(size_t growth) noexcept {
+        return growth + (growth - 1) / 7;
+    }
+
+    // 向上取整为 2^k-1 且不小于 S_min_capacity
+    static size_t S_normalize_capacity(size_t n) noexcept {
+        size_t capacity = S_min_capacity;
+        while (capacity < n) capacity = capacity * 2 + 1;
+        return capacity;
+    }
+
+    // 写控制字节，同时维护末尾的镜像字节
+    void M_set_ctrl(size_t i, Hashtable_ctrl h) noexcept {
+        M_ctrl[i] = h;
+        M_ctrl[((i - (S_width - 1)) & M_capacity) + ((S_width - 1) & M_capacity)] = h;
+    }
+
+    // 查找键所在的槽位，未找到时返回 M_capacity（即 end() 所指的哨兵位置）
+    template<typename Kt>
+    size_t M_find_index(const Kt& k, size_t hash) const {
+        Hashtable_probe_seq seq(S_h1(hash), M_capacity);
+        while (true) {
+            Group g(M_ctrl + seq.M_offset);
+            for (uint32_t m = g.M_match(S_h2(hash)); m; m &= m - 1) {
+                size_t i = seq.M_offset_of(__builtin_ctz(m));
+                if (M_eq(k, S_key(M_slots[i]))) {
+                    return i;
+                }
+            }
+            if (g.M_match_empty()) {
+                return M_capacity;
+            }
+            seq.M_next();
+        }
+    }
+
+    // 沿探测序列找到第一个空槽或墓碑
+    size_t M_find_first_non_full(size_t hash) const {
+        Hashtable_probe_seq seq(S_h1(hash), M_capacity);
+        while (true) {
+            uint32_t m = Group(M_ctrl + seq.M_offset).M_match_empty_or_deleted();
+            if (m) {
+                return seq.M_offset_of(__builtin_ctz(m));
+            }
+            seq.M_next();
+        }
+    }
+
+    // 为新元素占好一个槽位（只写控制字节，不构造值）
+    size_t M_prepare_insert(size_t hash) {
+        size_t target = M_find_first_non_full(hash);
+        if (M_growth_left == 0 && M_ctrl[target] != S_ctrl_deleted) {
+            M_rehash_and_grow_if_necessary();
+            target = M_find_first_non_full(hash);
+        }
+        ++M_size;
+        M_growth_left -= (M_ctrl[target] == S_ctrl_empty);
+        M_set_ctrl(target, S_h2(hash));
+        return target;
+    }
+
+    // 查找键，不存在时占好插入槽位；second 为 true 表示需要在该槽位上构造新元素
+    std::pair<size_t, bool> M_find_or_prepare_insert(const key_type& k) {
+        size_t hash = M_hash_of(k);
+        size_t i = M_find_index(k, hash);
+        if (i != M_capacity) {
+            return { i, false };
+        }
+        return { M_prepare_insert(hash), true };
+    }
+
+    // 在已占好的槽位上构造元素，构造失败时撤销占位
+    template<typename... Args>
+    void M_construct_at(size_t i, Args&&... args) {
+        try {
+            Alloc_traits::construct(M_alloc, M_slots + i, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            M_erase_meta(i);
+            throw;
+        }
+    }
+
+    // 删除槽位的控制信息：若任何探测序列都不可能经过此处则直接置空，否则留下墓碑
+    void M_erase_meta(size_t i) noexcept {
+        --M_size;
+        size_t before = (i - S_width) & M_capacity;
+        uint32_t empty_after  = Group(M_ctrl + i).M_match_empty();
+        uint32_t empty_before = Group(M_ctrl + before).M_match_empty();
+        bool was_never_full = empty_before && empty_after &&
+            Group::S_trailing_zeros(empty_after) + Group::S_leading_zeros(empty_before) < S_width;
+        M_set_ctrl(i, was_never_full ? S_ctrl_empty : S_ctrl_deleted);
+        M_growth_left += was_never_full;
+    }
+
+    void M_erase_at(size_t i) {
+        Alloc_traits::destroy(M_alloc, M_slots + i);
+        M_erase_meta(i);
+    }
+
+    // 墓碑较多时原地重建以清除墓碑，否则容量翻倍
+    void M_rehash_and_grow_if_necessary() {
+        if (M_capacity > S_width && M_size * 32 <= M_capacity * 25) {
+            M_resize(M_capacity);
+        }
+        else {
+            M_resize(M_capacity == 0 ? S_min_capacity : M_capacity * 2 + 1);
+        }
+    }
+
+    void M_resize(size_t new_capacity) {
+        Hashtable_ctrl* old_ctrl = M_ctrl;
+        Val* old_slots = M_slots;
+        size_t old_capacity = M_capacity;
+
+        Ctrl_allocator ctrl_alloc(M_alloc);
+        Hashtable_ctrl* new_ctrl = Ctrl_traits::allocate(ctrl_alloc, new_capacity + S_width);
+        Val* new_slots;
+        try {
+            new_slots = Alloc_traits::allocate(M_alloc, new_capacity);
+        }
+        catch (...) {
+            Ctrl_traits::deallocate(ctrl_alloc, new_ctrl, new_capacity + S_width);
+            throw;
+        }
+        std::memset(new_ctrl, S_ctrl_empty, new_capacity + S_width);
+        new_ctrl[new_capacity] = S_ctrl_sentinel;
+
+        M_ctrl = new_ctrl;
+        M_slots = new_slots;
+        M_capacity = new_capacity;
+        M_growth_left = S_capacity_to_growth(new_capacity) - M_size;
+
+        for (size_t i = 0; i != old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                size_t hash = M_hash_of(S_key(old_slots[i]));
+                size_t target = M_find_first_non_full(hash);
+                M_set_ctrl(target, S_h2(hash));
+                Alloc_traits::construct(M_alloc, M_slots + target, std::move(old_slots[i]));
+                Alloc_traits::destroy(M_alloc, old_slots + i);
+            }
+        }
+        if (old_capacity) {
+            Ctrl_traits::deallocate(ctrl_alloc, old_ctrl, old_capacity + S_width);
+            Alloc_traits::deallocate(M_alloc, old_slots, old_capacity);
+        }
+    }
+
+    // 销毁所有元素并归还内存
+    void M_destroy_and_deallocate() noexcept {
+        if (!M_capacity) return;
+        for (size_t i = 0; i != M_capacity; ++i) {
+            if (M_ctrl[i] >= 0) {
+                Alloc_traits::destroy(M_alloc, M_slots + i);
+            }
+        }
+        Ctrl_allocator ctrl_alloc(M_alloc);
+        Ctrl_traits::deallocate(ctrl_alloc, M_ctrl, M_capacity + S_width);
+        Alloc_traits::deallocate(M_alloc, M_slots, M_capacity);
+        M_reset();
+    }
+
+    void M_reset() noexcept {
+        M_ctrl = S_empty_group();
+        M_slots = nullptr;
+        M_size = M_capacity = M_growth_left = 0;
+    }
+
+    void M_move_data(Hashtable& x) noexcept {
+        M_ctrl = x.M_ctrl;
+        M_slots = x.M_slots;
+        M_size = x.M_size;
+        M_capacity = x.M_capacity;
+        M_growth_left = x.M_growth_left;
+        x.M_reset();
+    }
+
+    iterator M_iterator_at(size_t i) noexcept {
+        return iterator(M_ctrl + i, M_slots + i);
+    }
+
+    const_iterator M_iterator_at(size_t i) const noexcept {
+        return const_iterator(M_ctrl + i, M_slots + i);
+    }
+
+    size_t M_index_of(const_iterator pos) const noexcept {
+        return pos.M_ctrl - M_ctrl;
+    }
+
+public:
+    Hashtable() = default;
+
+    explicit Hashtable(size_type bucket_count, const Hash& hf = Hash(), const Equal& eql = Equal(),
+                       const allocator_type& a = allocator_type())
+        : M_hash(hf), M_eq(eql), M_alloc(a) {
+        if (bucket_count) {
+            M_resize(S_normalize_capacity(bucket_count));
+        }
+    }
+
+    Hashtable(const Hashtable& x)
+        : M_hash(x.M_hash), M_eq(x.M_eq), M_alloc(Alloc_traits::_S_select_on_copy(x.M_alloc)) {
+        reserve(x.size());
+        for (const_iterator it = x.begin(); it != x.end(); ++it) {
+            size_t hash = M_hash_of(S_key(*it));
+            M_construct_at(M_prepare_insert(hash), *it);
+        }
+    }
+
+    Hashtable(const Hashtable& x, const allocator_type& a) : M_hash(x.M_hash), M_eq(x.M_eq), M_alloc(a) {
+        reserve(x.size());
+        for (const_iterator it = x.begin(); it != x.end(); ++it) {
+            size_t hash = M_hash_of(S_key(*it));
+            M_construct_at(M_prepare_insert(hash), *it);
+        }
+    }
+
+    Hashtable(Hashtable&& x) noexcept
+        : M_hash(std::move(x.M_hash)), M_eq(std::move(x.M_eq)), M_alloc(std::move(x.M_alloc)) {
+        M_move_data(x);
+    }
+
+    ~Hashtable() {
+        M_destroy_and_deallocate();
+    }
+
+    Hashtable& operator=(const Hashtable& x) {
+        if (this != std::__addressof(x)) {
+            clear();
+            M_hash = x.M_hash;
+            M_eq = x.M_eq;
+            if (Alloc_traits::_S_propagate_on_copy_assign()) {
+                M_destroy_and_deallocate();
+                std::__alloc_on_copy(M_alloc, x.M_alloc);
+            }
+            reserve(x.size());
+            for (const_iterator it = x.begin(); it != x.end(); ++it) {
+                size_t hash = M_hash_of(S_key(*it));
+                M_construct_at(M_prepare_insert(hash), *it);
+            }
+        }
+        return *this;
+    }
+
+    Hashtable& operator=(Hashtable&& x) noexcept(Alloc_traits::_S_nothrow_move()) {
+        if (this == std::__addressof(x)) return *this;
+        M_hash = std::move(x.M_hash);
+        M_eq = std::move(x.M_eq);
+        if (Alloc_traits::_S_propagate_on_move_assign() || Alloc_traits::_S_always_equal() || M_alloc == x.M_alloc) {
+            M_destroy_and_deallocate();
+            std::__alloc_on_move(M_alloc, x.M_alloc);
+            M_move_data(x);
+        }
+        else {
+            // 分配器不相等时只能逐个移动元素
+            clear();
+            reserve(x.size());
+            for (iterator it = x.begin(); it != x.end(); ++it) {
+                size_t hash = M_hash_of(S_key(*it));
+                M_construct_at(M_prepare_insert(hash), std::move(*it));
+            }
+            x.clear();
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(M_alloc);
+    }
+
+    hasher hash_function() const {
+        return M_hash;
+    }
+
+    key_equal key_eq() const {
+        return M_eq;
+    }
+
+    iterator begin() noexcept {
+        return M_iterator_at(0);
+    }
+
+    const_iterator begin() const noexcept {
+        return M_iterator_at(0);
+    }
+
+    iterator end() noexcept {
+        return iterator(M_ctrl + M_capacity, M_slots + M_capacity);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(M_ctrl + M_capacity, M_slots + M_capacity);
+    }
+
+    bool empty() const noexcept {
+        return M_size == 0;
+    }
+
+    size_type size() const noexcept {
+        return M_size;
+    }
+
+    size_type max_size() const noexcept {
+        return Alloc_traits::max_size(M_alloc);
+    }
+
+    size_type bucket_count() const noexcept {
+        return M_capacity;
+    }
+
+    float load_factor() const noexcept {
+        return M_capacity ? static_cast<float>(M_size) / M_capacity : 0.0f;
+    }
+
+    float max_load_factor() const noexcept {
+        return 7.0f / 8.0f;
+    }
+
+    // 销毁所有元素但保留容量
+    void clear() noexcept {
+        if (!M_capacity) return;
+        for (size_t i = 0; i != M_capacity; ++i) {
+            if (M_ctrl[i] >= 0) {
+                Alloc_traits::destroy(M_alloc, M_slots + i);
+            }
+        }
+        std::memset(M_ctrl, S_ctrl_empty, M_capacity + S_width);
+        M_ctrl[M_capacity] = S_ctrl_sentinel;
+        M_size = 0;
+        M_growth_left = S_capacity_to_growth(M_capacity);
+    }
+
+    // 保证插入 n 个元素之前不会再扩容
+    void reserve(size_type n) {
+        if (n > M_size + M_growth_left) {
+            M_resize(S_normalize_capacity(S_growth_to_lower_bound_capacity(n)));
+        }
+    }
+
+    void rehash(size_type n) {
+        if (n == 0 && M_capacity == 0) return;
+        if (n == 0 && M_size == 0) {
+            M_destroy_and_deallocate();
+            return;
+        }
+        size_t m = S_normalize_capacity(std::max(n, S_growth_to_lower_bound_capacity(M_size)));
+        if (n == 0 || m > M_capacity) {
+            M_resize(m);
+        }
+    }
+
+    void swap(Hashtable& x) noexcept(__is_nothrow_swappable<Hash>::value && __is_nothrow_swappable<Equal>::value) {
+        using std::swap;
+        swap(M_ctrl, x.M_ctrl);
+        swap(M_slots, x.M_slots);
+        swap(M_size, x.M_size);
+        swap(M_capacity, x.M_capacity);
+        swap(M_growth_left, x.M_growth_left);
+        swap(M_hash, x.M_hash);
+        swap(M_eq, x.M_eq);
+        Alloc_traits::_S_on_swap(M_alloc, x.M_alloc);
+    }
+
+    // 唯一插入，Arg 为 value_type（或可转换为 value_type）
+    template<typename Arg>
+    std::pair<iterator, bool> M_insert_unique(Arg&& v) {
+        auto res = M_find_or_prepare_insert(S_key(v));
+        if (res.second) {
+            M_construct_at(res.first, std::forward<Arg>(v));
+        }
+        return { M_iterator_at(res.first), res.second };
+    }
+
+    // 原地构造唯一插入：先构造出值才能取得键
+    template<typename... Args>
+    std::pair<iterator, bool> M_emplace_unique(Args&&... args) {
+        value_type tmp(std::forward<Args>(args)...);
+        return M_insert_unique(std::move(tmp));
+    }
+
+    // 仅在键不存在时用 args 构造映射值（用于 map 的 try_emplace / operator[]）
+    template<typename Kt, typename... Args>
+    std::pair<iterator, bool> M_try_emplace(Kt&& k, Args&&... args) {
+        auto res = M_find_or_prepare_insert(k);
+        if (res.second) {
+            M_construct_at(res.first, std::piecewise_construct, std::forward_as_tuple(std::forward<Kt>(k)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        return { M_iterator_at(res.first), res.second };
+    }
+
+    template<typename InputIterator>
+    void M_insert_range_unique(InputIterator first, InputIterator last) {
+        using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            reserve(M_size + std::distance(first, last));
+        }
+        for (; first != last; ++first) {
+            M_emplace_unique(*first);
+        }
+    }
+
+    iterator find(const key_type& k) {
+        return M_iterator_at(M_find_index(k, M_hash_of(k)));
+    }
+
+    const_iterator find(const key_type& k) const {
+        return M_iterator_at(M_find_index(k, M_hash_of(k)));
+    }
+
+    size_type count(const key_type& k) const {
+        return M_find_index(k, M_hash_of(k)) == M_capacity ? 0 : 1;
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& k) {
+        iterator it = find(k);
+        if (it == end()) return { it, it };
+        iterator next = it;
+        return { it, ++next };
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+        const_iterator it = find(k);
+        if (it == end()) return { it, it };
+        const_iterator next = it;
+        return { it, ++next };
+    }
+
+    iterator erase(const_iterator position) {
+        __glibcxx_assert(position != end());
+        size_t i = M_index_of(position);
+        M_erase_at(i);
+        return M_iterator_at(i + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        size_t i = M_index_of(last);
+        return M_iterator_at(i);
+    }
+
+    size_type erase(const key_type& k) {
+        size_t i = M_find_index(k, M_hash_of(k));
+        if (i == M_capacity) return 0;
+        M_erase_at(i);
+        return 1;
+    }
+
+    // 提取一个节点：值被移动到新分配的节点中，槽位随即释放
+    node_type extract(const_iterator pos) {
+        size_t i = M_index_of(pos);
+        Node_allocator node_alloc(M_alloc);
+        Hashtable_node<Val>* node = Node_traits::allocate(node_alloc, 1);
+        try {
+            ::new(node) Hashtable_node<Val>;
+            Alloc_traits::construct(M_alloc, node->M_valptr(), std::move(M_slots[i]));
+        }
+        catch (...) {
+            node->~Hashtable_node<Val>();
+            Node_traits::deallocate(node_alloc, node, 1);
+            throw;
+        }
+        M_erase_at(i);
+        return node_type(node, node_alloc);
+    }
+
+    node_type extract(const key_type& k) {
+        node_type nh;
+        size_t i = M_find_index(k, M_hash_of(k));
+        if (i != M_capacity) {
+            nh = extract(M_iterator_at(i));
+        }
+        return nh;
+    }
+
+    // 重新插入提取的节点，成功时节点被释放
+    insert_return_type M_reinsert_node_unique(node_type&& nh) {
+        insert_return_type ret;
+        if (nh.empty()) {
+            ret.position = end();
+            return ret;
+        }
+        auto res = M_find_or_prepare_insert(S_key(nh.value()));
+        if (res.second) {
+            M_construct_at(res.first, std::move(nh.value()));
+            nh._M_reset();
+            ret.inserted = true;
+        }
+        else {
+            ret.node = std::move(nh);
+            ret.inserted = false;
+        }
+        ret.position = M_iterator_at(res.first);
+        return ret;
+    }
+
+    template<typename Equal2, typename Hash2>
+    using Compatible_table = Hashtable<Key, Val, Alloc, ExtractKey, Equal2, Hash2>;
+
+    // 从兼容的表中合并：本表中不存在的键被移动过来并从源表删除
+    template<typename Equal2, typename Hash2>
+    void M_merge_unique(Compatible_table<Equal2, Hash2>& src) {
+        if (static_cast<void*>(this) == static_cast<void*>(&src)) return;
+        reserve(M_size + src.size());
+        for (size_t i = 0; i != src.M_capacity; ++i) {
+            if (src.M_ctrl[i] < 0) continue;
+            auto res = M_find_or_prepare_insert(S_key(src.M_slots[i]));
+            if (res.second) {
+                M_construct_at(res.first, std::move(src.M_slots[i]));
+                src.M_erase_at(i);
+            }
+        }
+    }
+
+    friend bool operator==(const Hashtable& x, const Hashtable& y) {
+        if (x.size() != y.size()) return false;
+        for (const_iterator it = x.begin(); it != x.end(); ++it) {
+            const_iterator j = y.find(S_key(*it));
+            if (j == y.end() || !(*it == *j)) return false;
+        }
+        return true;
+    }
+};
+
+template<typename Key, typename Val, typename Alloc, typename ExtractKey, typename Equal, typename Hash>
+inline void swap(Hashtable<Key, Val, Alloc, ExtractKey, Equal, Hash>& x,
+                 Hashtable<Key, Val, Alloc, ExtractKey, Equal, Hash>& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+}
+
+#endif // HASHTABLE_H
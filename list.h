@@ -4,16 +4,21 @@
 //#include <memory>
 #include"allocator.h"
 #include <initializer_list>
-#include <type_traits> 
+#include <type_traits>
+
+// 节点的链接部分；哨兵节点只有这一部分，直接嵌在 List 对象里，不需要分配内存，也不构造 T
+struct ListNodeBase {
+    ListNodeBase* prev = nullptr;
+    ListNodeBase* next = nullptr;
+};
 
 // 节点结构
 template <typename T>
-struct ListNode {
+struct ListNode : ListNodeBase {
     T data;
-    ListNode* prev;
-    ListNode* next;
 
-    ListNode(const T& value) : data(value), prev(nullptr), next(nullptr) {}
+    template <typename... Args>
+    explicit ListNode(Args&&... args) : data(std::forward<Args>(args)...) {}
 };
 
 // 迭代器
@@ -27,7 +32,11 @@ public:
     using pointer  = std::conditional_t<IsConst, const T*, T*>;  // 根据IsConst的类型判断指针类型
     using reference = std::conditional_t<IsConst, const T&, T&>;
 
-    ListIterator(ListNode<T>* node) : current(node) {}
+    ListIterator(ListNodeBase* node = nullptr) : current(node) {}
+
+    // iterator 可以隐式转换为 const_iterator
+    template <bool C = IsConst, typename = std::enable_if_t<C>>
+    ListIterator(const ListIterator<T, false>& other) : current(other.getNode()) {}
 
     ListIterator& operator++() {
         current = current->next;
@@ -59,42 +68,140 @@ public:
         return !(*this == other);
     }
 
-    T& operator*() const { return this->current->data; }
-    T* operator->() const { return &(this->current->data); }
+    reference operator*() const { return static_cast<ListNode<T>*>(current)->data; }
+    pointer operator->() const { return &(static_cast<ListNode<T>*>(current)->data); }
 
     // 获取当前节点指针
-    ListNode<T>* getNode() const {
+    ListNodeBase* getNode() const {
         return current;
     }
 
 protected:
-    ListNode<T>* current;
+    ListNodeBase* current;
 };
 
 // List 容器类
-template <typename T, typename Alloc = Allocator<ListNode<T>>>
+// 被删除的节点先留在链表自己的空闲链里（最多 CachedNodes 个），之后的插入优先复用，
+// 反复删除、插入（如 LRU 链表）的稳定状态下不再调用分配器；CachedNodes 为 0 时每次都直接分配 / 释放。
+// 需要从 slab 中切分节点时可以配合 Pool_allocator：List<T, Pool_allocator<ListNode<T>>>
+template <typename T, typename Alloc = Allocator<ListNode<T>>, size_t CachedNodes = 64>
 class List {
 
 private:
-    ListNode<T>* head;  // 头部哨兵节点
-    ListNode<T>* tail;  // 尾部哨兵节点
+    using Node = ListNode<T>;
+
+    ListNodeBase head;  // 头部哨兵节点
+    ListNodeBase tail;  // 尾部哨兵节点
     Alloc allocator;
     size_t size_;
+    ListNodeBase* free_nodes_;  // 回收的节点，用 next 串成单链表，只有内存没有对象
+    size_t cached_count_;
 
     // 初始化哨兵节点
     void initialize_sentinel_nodes() {
-        head = allocator.allocate(1);
-        tail = allocator.allocate(1);
-        allocator.construct(head, ListNode<T>(T()));
-        allocator.construct(tail, ListNode<T>(T()));
-        head->next = tail;
-        tail->prev = head;
+        head.prev = nullptr;
+        head.next = &tail;
+        tail.prev = &head;
+        tail.next = nullptr;
+    }
+
+    // 把 [first, last] 这条链挂到两个哨兵之间，n 为链上的元素个数
+    void attach(ListNodeBase* first, ListNodeBase* last, size_t n) {
+        if (n == 0) {
+            initialize_sentinel_nodes();
+        } else {
+            head.next = first;
+            first->prev = &head;
+            tail.prev = last;
+            last->next = &tail;
+        }
+        size_ = n;
+    }
+
+    // 接管 other 的全部节点，other 变为空链表
+    void take_nodes(List& other) {
+        attach(other.head.next, other.tail.prev, other.size_);
+        other.initialize_sentinel_nodes();
+        other.size_ = 0;
+    }
+
+    // 取一块节点内存：优先从空闲链取
+    Node* acquire_node() {
+        if (free_nodes_) {
+            ListNodeBase* node = free_nodes_;
+            free_nodes_ = node->next;
+            --cached_count_;
+            return static_cast<Node*>(node);
+        }
+        return allocator.allocate(1);
+    }
+
+    // 归还节点内存（对象已析构）：空闲链未满时留下复用
+    void release_node(Node* node) {
+        if (cached_count_ < CachedNodes) {
+            ListNodeBase* base = node;
+            base->next = free_nodes_;
+            free_nodes_ = base;
+            ++cached_count_;
+        } else {
+            allocator.deallocate(node, 1);
+        }
+    }
+
+    // 释放空闲链上的全部节点
+    void drop_cached_nodes() {
+        while (free_nodes_) {
+            ListNodeBase* node = free_nodes_;
+            free_nodes_ = node->next;
+            allocator.deallocate(static_cast<Node*>(node), 1);
+        }
+        cached_count_ = 0;
+    }
+
+    template <typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* node = acquire_node();
+        try {
+            allocator.construct(node, std::forward<Args>(args)...);
+        } catch (...) {
+            release_node(node);
+            throw;
+        }
+        return node;
+    }
+
+    void destroy_node(ListNodeBase* node) {
+        Node* p = static_cast<Node*>(node);
+        allocator.destroy(p);
+        release_node(p);
+    }
+
+    // 把 node 链接到 where 之前
+    void link_before(ListNodeBase* where, ListNodeBase* node) {
+        node->prev = where->prev;
+        node->next = where;
+        where->prev->next = node;
+        where->prev = node;
+        ++size_;
+    }
+
+    // 把 node 从链上摘下，返回它的后继
+    ListNodeBase* unlink(ListNodeBase* node) {
+        ListNodeBase* next = node->next;
+        node->prev->next = next;
+        next->prev = node->prev;
+        --size_;
+        return next;
+    }
+
+    static T& value_of(ListNodeBase* node) {
+        return static_cast<Node*>(node)->data;
     }
 
     // 创建默认初始化的元素
     void resize_default(size_t count) {
         for (size_type i = 0; i < count; ++i) {
-            emplace_back(T());
+            emplace_back();
         }
     }
 
@@ -114,12 +221,12 @@ public:
     using size_type              = size_t;
 
     // 默认构造函数，使用默认分配器
-    List() : size_(0), allocator() {
+    List() : allocator(), size_(0), free_nodes_(nullptr), cached_count_(0) {
         initialize_sentinel_nodes();
     }
 
     // 使用指定分配器创建空列表
-    explicit List(const Alloc& al) : allocator(al), size_(0) {
+    explicit List(const Alloc& al) : allocator(al), size_(0), free_nodes_(nullptr), cached_count_(0) {
         initialize_sentinel_nodes();
     }
 
@@ -134,35 +241,24 @@ public:
     }
 
     // 创建Count个Val的副本，使用指定分配器
-    List(size_type count, const T& val, const Alloc& al) : allocator(al), size_(0) {
-        initialize_sentinel_nodes();
+    List(size_type count, const T& val, const Alloc& al) : List(al) {
         assign(count, val);
     }
 
     // 拷贝构造函数
-    List(List& other) : allocator(other.get_allocator()), size_(0) {
-        initialize_sentinel_nodes();
+    List(const List& other) : List(other.get_allocator()) {
         for (auto it = other.begin(); it != other.end(); it++) {
             push_back(*it);
         }
     }
 
-    // 移动构造函数
-    List(List&& other) noexcept 
-        : head(other.head), tail(other.tail), allocator(std::move(other.allocator)), size_(other.size_) {
-        // 重置原对象的哨兵节点
-        other.head = other.allocator.allocate(1);
-        other.tail = other.allocator.allocate(1);
-        other.allocator.construct(other.head, ListNode<T>(T()));
-        other.allocator.construct(other.tail, ListNode<T>(T()));
-        other.head->next = other.tail;
-        other.tail->prev = other.head;
-        other.size_ = 0;
+    // 移动构造函数：哨兵在对象内部，只需把 other 的节点链重新挂到本对象的哨兵上
+    List(List&& other) noexcept : List(other.allocator) {
+        take_nodes(other);
     }
 
     // 初始化列表构造函数
-    List(std::initializer_list<T> IList, const Alloc& al = Alloc()) : allocator(al), size_(0) {
-        initialize_sentinel_nodes();
+    List(std::initializer_list<T> IList, const Alloc& al = Alloc()) : List(al) {
         for (const auto& val : IList) {
             push_back(val);
         }
@@ -170,8 +266,7 @@ public:
 
     // 迭代器范围构造函数
     template <class InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
-    List(InputIterator First, InputIterator Last, const Alloc& al = Alloc()) : allocator(al), size_(0) {
-        initialize_sentinel_nodes();
+    List(InputIterator First, InputIterator Last, const Alloc& al = Alloc()) : List(al) {
         assign(First, Last);
     }
 
@@ -190,78 +285,48 @@ public:
     List& operator=(List&& right){
         if (this != &right) {  // 避免自我赋值
             clear();
-            head = std::move(right.head);
-            tail = std::move(right.tail);
-            size_ = std::move(right.size_);
-            // 将 right 置为空列表
-            right.head = right.allocator.allocate(1);
-            right.tail = right.allocator.allocate(1);
-            right.head->next = right.tail;
-            right.tail->prev = right.head;
-            right.size_ = 0;
+            take_nodes(right);
         }
         return *this;
     }
 
     ~List() {
         clear();
-        allocator.destroy(head);
-        allocator.deallocate(head, 1);
-        allocator.destroy(tail);
-        allocator.deallocate(tail, 1);
+        drop_cached_nodes();
     }
 
     // 在尾部插入元素
     void push_back(const T& value) {
-        ListNode<T>* newNode = allocator.allocate(1);
-        allocator.construct(newNode, ListNode<T>(value));
-        newNode->prev = tail->prev;
-        newNode->next = tail;
-        tail->prev->next = newNode;
-        tail->prev = newNode;
-        ++size_;
+        link_before(&tail, create_node(value));
+    }
+
+    void push_back(T&& value) {
+        link_before(&tail, create_node(std::move(value)));
     }
 
     // 在头部插入元素
     void push_front(const T& value) {
-        // 分配新节点的内存
-        ListNode<T>* newNode = allocator.allocate(1);
-        allocator.construct(newNode, ListNode<T>(value));
-
-        newNode->prev = head;
-        newNode->next = head->next;
-
-        // 如果列表为空（头哨兵节点的下一个节点是尾哨兵节点）
-        if (head->next == tail) {
-            tail->prev = newNode;
-        } else {
-            head->next->prev = newNode;
-        }
+        link_before(head.next, create_node(value));
+    }
 
-        head->next = newNode;
-        ++size_;
+    void push_front(T&& value) {
+        link_before(head.next, create_node(std::move(value)));
     }
 
     // 删除尾部元素
     void pop_back() {
         if (empty()) return;
-        ListNode<T>* temp = tail->prev;
-        tail->prev->prev->next = tail;
-        tail->prev = tail->prev->prev;
-        allocator.destroy(temp);
-        allocator.deallocate(temp, 1);
-        --size_;
+        ListNodeBase* temp = tail.prev;
+        unlink(temp);
+        destroy_node(temp);
     }
 
     // 删除头部元素
     void pop_front() {
         if (empty()) return;
-        ListNode<T>* temp = head->next;
-        head->next->next->prev = head;
-        head->next = head->next->next;
-        allocator.destroy(temp);
-        allocator.deallocate(temp, 1);
-        --size_;
+        ListNodeBase* temp = head.next;
+        unlink(temp);
+        destroy_node(temp);
     }
 
     //清除列表中的元素，并将一组新元素复制到目标列表
@@ -289,7 +354,11 @@ public:
     }
 
     iterator begin() {
-        return iterator(head->next);
+        return iterator(head.next);
+    }
+
+    const_iterator begin() const {
+        return cbegin();
     }
 
     reverse_iterator rbegin() {
@@ -297,7 +366,7 @@ public:
     }
 
     const_iterator cbegin() const {
-        return const_iterator(head->next);
+        return const_iterator(head.next);
     }
 
     const_reverse_iterator crbegin() const {
@@ -305,11 +374,15 @@ public:
     }
 
     iterator end() {
-        return iterator(tail);
+        return iterator(&tail);
+    }
+
+    const_iterator end() const {
+        return cend();
     }
 
     const_iterator cend() const {
-        return const_iterator(tail);
+        return const_iterator(const_cast<ListNodeBase*>(&tail));
     }
 
     reverse_iterator rend() {
@@ -321,39 +394,37 @@ public:
     }
 
     reference back(){
-        return tail->prev->data;
+        return value_of(tail.prev);
     }
 
     const_reference back() const{
-        return tail->prev->data;
+        return value_of(tail.prev);
     }
 
     reference front(){
-        return head->next->data;
+        return value_of(head.next);
     }
 
     const_reference front() const{
-        return head->next->data;
+        return value_of(head.next);
     }
 
     //将构造的元素插入到列表中的指定位置
-    void emplace(iterator Where, const T& val) {
-        ListNode<T>* newNode = allocator.allocate(1);
-        allocator.construct(newNode, val);
-
-        newNode->prev = Where.getNode()->prev;
-        newNode->next = Where.getNode();
-        Where.getNode()->prev->next = newNode;
-        Where.getNode()->prev = newNode;
-        ++size_;
+    template <typename... Args>
+    iterator emplace(const_iterator Where, Args&&... args) {
+        Node* newNode = create_node(std::forward<Args>(args)...);
+        link_before(Where.getNode(), newNode);
+        return iterator(newNode);
     }
 
-    void emplace_back(value_type&& val){
-        push_back(std::move(val));
+    template <typename... Args>
+    void emplace_back(Args&&... args){
+        link_before(&tail, create_node(std::forward<Args>(args)...));
     }
 
-    void emplace_front(value_type&& val){
-        push_front(std::move(val));
+    template <typename... Args>
+    void emplace_front(Args&&... args){
+        link_before(head.next, create_node(std::forward<Args>(args)...));
     }
 
     // 判断容器是否为空
@@ -366,227 +437,153 @@ public:
         return size_;
     }
 
-    // 清除容器
+    // 清除容器；节点按 CachedNodes 的上限留在空闲链里
     void clear() {
-        ListNode<T>* current = head->next;
-        while (current != tail) {
-            if(!current || !current->next) return;
-            ListNode<T>* next = current->next;
-            allocator.destroy(current);
-            allocator.deallocate(current, 1);
+        ListNodeBase* current = head.next;
+        while (current != &tail) {
+            ListNodeBase* next = current->next;
+            destroy_node(current);
             current = next;
         }
-        head->next = tail;
-        tail->prev = head;
+        initialize_sentinel_nodes();
         size_ = 0;
     }
 
+    // 释放空闲链上缓存的节点
+    void shrink_to_fit() {
+        drop_cached_nodes();
+    }
+
     //从列表中的指定位置移除一个或一系列元素
-    iterator erase(iterator Where){
-        ListNode<T>* node = Where.getNode();
-        if(node == nullptr || node == tail || node == head) return iterator(nullptr);
-        //为头时
-        if(node == tail->prev) {
-            pop_back();
-            return iterator(nullptr);
-        }
-        //为尾时
-        if(node == head->next){
-            pop_front();
-            return iterator(head->next);
-        }
-        //中间
-        ListNode<T>* temp = node->next;
-        node->prev->next = node->next;
-        node->next->prev = node->prev;
-        allocator.destroy(node);
-        allocator.deallocate(node, 1);
-        size_--;
-        return iterator(temp);
+    iterator erase(const_iterator Where){
+        ListNodeBase* node = Where.getNode();
+        if(node == &tail || node == &head) return iterator(node);
+        ListNodeBase* next = unlink(node);
+        destroy_node(node);
+        return iterator(next);
     }
 
-    iterator erase(iterator first, iterator last){
+    iterator erase(const_iterator first, const_iterator last){
         while(first != last){
-            iterator temp = first;
-            ++first;
-            erase(temp);
+            first = erase(first);
         }
-        return first;
+        return iterator(last.getNode());
     }
 
     //返回用于构造列表的分配器对象的一个副本
     allocator_type get_allocator() const{
-        return allocator_type();
+        return allocator;
     }
 
     //将一个、几个或一系列元素插入列表中的指定位置
-    iterator insert(iterator Where, const value_type& Val){
-
-        ListNode<T>* newNode = allocator.allocate(1);
-        allocator.construct(newNode, ListNode<T>(Val));
-        Where.getNode()->prev->next = newNode;
-        newNode->prev = Where.getNode()->prev;
-        Where.getNode()->prev = newNode;
-        newNode->next = Where.getNode();
-
-        size_++;
-
-        return iterator(newNode);
+    iterator insert(const_iterator Where, const value_type& Val){
+        return emplace(Where, Val);
     }
 
-    iterator insert(iterator Where, value_type&& Val){
-
-        ListNode<T>* newNode = allocator.allocate(1);
-        allocator.construct(newNode, move(Val));
-        Where.getNode()->prev->next = newNode;
-        newNode->prev = Where.getNode()->prev;
-        Where.getNode()->prev = newNode;
-        newNode->next = Where.getNode();
-
-        size_++;
-
-        return iterator(newNode);
+    iterator insert(const_iterator Where, value_type&& Val){
+        return emplace(Where, std::move(Val));
     }
 
-    void insert(iterator Where, size_type Count, const value_type& Val){
+    void insert(const_iterator Where, size_type Count, const value_type& Val){
         while(Count--){
             Where = insert(Where, Val);
         }
     }
 
-    iterator insert(iterator Where, initializer_list<value_type> IList){
-        size_t i = 0;
-        iterator temp(nullptr);
-        for(auto Val : IList){
-            Where = insert(Where, Val);
-            if(!i++) temp = Where;
-            Where++;
-        }
-        return temp;
+    iterator insert(const_iterator Where, initializer_list<value_type> IList){
+        return insert(Where, IList.begin(), IList.end());
     }
 
+    // 返回指向第一个插入元素的迭代器，没有插入时返回 Where
     template <class InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
-    void insert(iterator Where, InputIterator First, InputIterator Last){
+    iterator insert(const_iterator Where, InputIterator First, InputIterator Last){
+        iterator first(Where.getNode());
+        bool inserted = false;
         while(First != Last){
-            Where = insert(Where, *First++);
-            Where++;
+            iterator it = insert(Where, *First++);
+            if(!inserted) {
+                first = it;
+                inserted = true;
+            }
         }
+        return first;
     }
 
     //合并两个链表
     void merge(List& other) {
         if (this == &other || other.empty()) return;
 
-        if (empty()) {
-            // 当前链表为空，直接接管other的节点
-            head->next = other.head->next;
-            other.head->next->prev = head;
-            tail->prev = other.tail->prev;
-            other.tail->prev->next = tail;
-            size_ = other.size_;
-            other.head->next = other.tail;
-            other.tail->prev = other.head;
-            other.size_ = 0;
-            return;
-        }
-
-        ListNode<T>* this_current = head->next;
-        ListNode<T>* other_current = other.head->next;
-        ListNode<T>* merged_tail = head;
+        ListNodeBase* this_current = head.next;
+        ListNodeBase* other_current = other.head.next;
 
-        while (this_current != tail && other_current != other.tail) {
-            if (this_current->data <= other_current->data) {
-                merged_tail->next = this_current;
-                this_current->prev = merged_tail;
-                merged_tail = this_current;
+        while (this_current != &tail && other_current != &other.tail) {
+            if (value_of(this_current) <= value_of(other_current)) {
                 this_current = this_current->next;
             } else {
-                ListNode<T>* next_other = other_current->next;
-                // 从other中移除节点
-                other_current->prev->next = next_other;
-                next_other->prev = other_current->prev;
-
-                // 插入到当前链表
-                merged_tail->next = other_current;
-                other_current->prev = merged_tail;
-                other_current->next = this_current;
-                this_current->prev = other_current;
-
-                merged_tail = other_current;
+                // 从other中移除节点，插入到当前链表
+                ListNodeBase* next_other = other.unlink(other_current);
+                link_before(this_current, other_current);
                 other_current = next_other;
-                --other.size_;
-                ++size_;
             }
         }
 
         // 处理剩余的other节点
-        if (other_current != other.tail) {
-            merged_tail->next = other_current;
-            other_current->prev = merged_tail;
-
-            // 更新当前链表的尾节点
-            tail->prev = other.tail->prev;
-            other.tail->prev->next = tail;
-
+        if (other_current != &other.tail) {
+            ListNodeBase* last = other.tail.prev;
+            other_current->prev = tail.prev;
+            tail.prev->next = other_current;
+            last->next = &tail;
+            tail.prev = last;
             size_ += other.size_;
-            other.size_ = 0;
         }
 
         // 重置other的哨兵节点和大小
-        other.head->next = other.tail;
-        other.tail->prev = other.head;
+        other.initialize_sentinel_nodes();
         other.size_ = 0;
     }
 
+    // 稳定的归并排序，只重新链接节点，不分配也不拷贝元素。
+    // 逐个取下元素放进 carry，与 buckets 中长度为 1、2、4…的有序段依次合并
     void sort() {
         if (size_ <= 1) return;
 
-        List<T> tempList;
-        tempList.initialize_sentinel_nodes();
-
-        size_t blockSize = 1;
-        while (blockSize < size_) {
-            // 将原链表内容转移到临时链表
-            tempList.clear();
-            ListNode<T>* current = head->next;
-            while (current != tail) {
-                // 分割块并合并到临时链表
-                ListNode<T>* left = current;
-                ListNode<T>* leftEnd = split(left, blockSize);
-                ListNode<T>* right = leftEnd;
-                ListNode<T>* rightEnd = split(right, blockSize);
-
-                // 合并到临时链表
-                mergeToTemp(tempList, left, leftEnd, right, rightEnd);
-                current = rightEnd;
-            }
+        List carry(allocator);
+        List buckets[64];
+        List* fill = buckets;
+        List* counter;
 
-            // 将临时链表内容移回原链表
-            clear();
-            for (auto& val : tempList) {
-                push_back(val);
+        do {
+            carry.splice(carry.begin(), *this, begin());
+            for (counter = buckets; counter != fill && !counter->empty(); ++counter) {
+                counter->merge(carry);
+                carry.swap(*counter);
             }
+            carry.swap(*counter);
+            if (counter == fill) ++fill;
+        } while (!empty());
 
-            blockSize *= 2;
+        for (counter = buckets + 1; counter != fill; ++counter) {
+            counter->merge(*(counter - 1));
         }
+        take_nodes(*(fill - 1));
     }
 
         //清除列表中与指定值匹配的元素
     void remove(const value_type& val){
-        for(ListNode<T>* node = head->next; node != tail && node; node = node->next){
-            if(node->data == val){
-                erase(iterator(node));
-            }
-        }
+        remove_if([&val](const value_type& x) { return x == val; });
     }
 
     //将满足指定谓词的元素从列表中消除
     template <class Predicate>
     void remove_if(Predicate pred){
-        for(ListNode<T>* node = head->next; node != tail && node; node = node->next){
-            if(pred(node->data)){
-                erase(iterator(node));
+        ListNodeBase* node = head.next;
+        while(node != &tail){
+            ListNodeBase* next = node->next;
+            if(pred(value_of(node))){
+                unlink(node);
+                destroy_node(node);
             }
+            node = next;
         }
     }
 
@@ -596,7 +593,7 @@ public:
             pop_back();
         }
         while(size_ < _Newsize){
-            push_back(T());
+            emplace_back();
         }
     }
 
@@ -605,37 +602,36 @@ public:
             pop_back();
         }
         while(size_ < _Newsize){
-            push_back(T(val));
+            push_back(val);
         }
     }
 
     //反转列表中元素的顺序
     void reverse(){
-        ListNode<T>* temp = nullptr;
-        for(ListNode<T>* node = head; node != nullptr;){
-            temp = node->prev;
-            node->prev = node->next;
-            node->next = temp;
-            node = node->prev;
+        if (size_ < 2) return;
+        ListNodeBase* node = head.next;
+        while (node != &tail) {
+            ListNodeBase* next = node->next;
+            std::swap(node->prev, node->next);
+            node = next;
         }
-        temp = head;
-        head = tail;
-        tail = temp;
+        std::swap(head.next, tail.prev);
+        head.next->prev = &head;
+        tail.prev->next = &tail;
     }
 
     //从源列表中删除元素并将其插入到目标列表中
     // insert the entire source list
-    void splice(iterator Where, List<value_type, Alloc>& Source) {
+    void splice(const_iterator Where, List& Source) {
         if (this == &Source || Source.empty()) return;
 
-        ListNode<T>* whereNode = Where.getNode();
-        ListNode<T>* sourceFirst = Source.head->next;  // 源链表的第一个实际节点
-        ListNode<T>* sourceLast = Source.tail->prev;   // 源链表的最后一个实际节点
+        ListNodeBase* whereNode = Where.getNode();
+        ListNodeBase* sourceFirst = Source.head.next;  // 源链表的第一个实际节点
+        ListNodeBase* sourceLast = Source.tail.prev;   // 源链表的最后一个实际节点
 
         // 从源链表断开节点
-        Source.head->next = Source.tail;
-        Source.tail->prev = Source.head;
         size_ += Source.size_;
+        Source.initialize_sentinel_nodes();
         Source.size_ = 0;
 
         // 将源链表的节点插入目标链表
@@ -646,43 +642,37 @@ public:
     }
 
     // 插入整个源列表（右值引用）
-    void splice(iterator Where, List<value_type, Alloc>&& Source) {
+    void splice(const_iterator Where, List&& Source) {
         splice(Where, Source);
     }
 
 
     // insert one element of the source list
-    void splice(iterator Where, List<value_type, Alloc>& Source, iterator Iter) {
-        if (this == &Source || Iter == Source.end()) return;
+    void splice(const_iterator Where, List& Source, const_iterator Iter) {
+        if (this == &Source || Iter == Source.cend()) return;
 
-        ListNode<T>* whereNode = Where.getNode();
-        ListNode<T>* sourceNode = Iter.getNode();
-
-        // 从源链表断开该节点
-        sourceNode->prev->next = sourceNode->next;
-        sourceNode->next->prev = sourceNode->prev;
-        Source.size_--;
-
-        // 插入到目标链表
-        sourceNode->prev = whereNode->prev;
-        sourceNode->next = whereNode;
-        whereNode->prev->next = sourceNode;
-        whereNode->prev = sourceNode;
+        ListNodeBase* sourceNode = Iter.getNode();
 
-        size_++;
+        // 从源链表断开该节点，插入到目标链表
+        Source.unlink(sourceNode);
+        link_before(Where.getNode(), sourceNode);
     }
-    
-    void splice(iterator Where, List<value_type, Alloc>&& Source, iterator Iter){
+
+    void splice(const_iterator Where, List&& Source, const_iterator Iter){
         splice(Where, Source, Iter);
     }
 
     // insert a range of elements from the source list
-    void splice(iterator Where, List<value_type, Alloc>& Source, iterator First, iterator Last) {
+    void splice(const_iterator Where, List& Source, const_iterator First, const_iterator Last) {
         if (this == &Source || First == Last) return;
 
-        ListNode<T>* whereNode = Where.getNode();
-        ListNode<T>* firstNode = First.getNode();
-        ListNode<T>* lastNode = Last.getNode()->prev;  // Last 是哨兵节点，需取前一个
+        // 先数出范围内的元素个数，断开之后就无法从 First 走到 Last 了
+        size_t movedSize = 0;
+        for (auto it = First; it != Last; ++it) movedSize++;
+
+        ListNodeBase* whereNode = Where.getNode();
+        ListNodeBase* firstNode = First.getNode();
+        ListNodeBase* lastNode = Last.getNode()->prev;  // Last 不在范围内，需取前一个
 
         // 从源链表断开范围 [firstNode, lastNode]
         firstNode->prev->next = Last.getNode();
@@ -695,114 +685,53 @@ public:
         whereNode->prev = lastNode;
 
         // 更新大小
-        size_t movedSize = 0;
-        for (auto it = First; it != Last; ++it) movedSize++;
         size_ += movedSize;
         Source.size_ -= movedSize;
     }
 
-    void splice(iterator Where, List<value_type, Alloc>&& Source, iterator First, iterator Last){
+    void splice(const_iterator Where, List&& Source, const_iterator First, const_iterator Last){
         splice(Where, Source, First, Last);
     }
 
-    template<typename Type_1, typename Allocator_1>
-    void swap(List<Type_1, Allocator_1>& right){    
-        std::swap(head, right.head);
-        std::swap(tail, right.tail);
+    // 交换两个链表的节点链与空闲链
+    void swap(List& right){
+        if (this == &right) return;
+        ListNodeBase* first = head.next;
+        ListNodeBase* last = tail.prev;
+        size_t count = size_;
+        attach(right.head.next, right.tail.prev, right.size_);
+        right.attach(first, last, count);
 
-        // 交换大小信息
-        std::swap(size_, right.size_);
+        std::swap(free_nodes_, right.free_nodes_);
+        std::swap(cached_count_, right.cached_count_);
 
         // 交换分配器（如果分配器支持交换)
-        if constexpr (std::allocator_traits<Allocator_1>::propagate_on_container_swap::value) {
+        if constexpr (std::allocator_traits<Alloc>::propagate_on_container_swap::value) {
             std::swap(allocator, right.allocator);
         }
     }
 
     //从列表中删除满足某些其他二元谓词的相邻重复元素或相邻元素
     void unique(){
-        ListNode<T>* node = head->next->next;
-        T temp = head->next->data;
-        while(node != tail){
-            if(temp == node->data){
-                ListNode<T>* tp = node;
-                node = node->prev;
-                tp->prev->next = tp->next;
-                tp->next->prev = tp->prev;
-                allocator.destroy(tp);
-                allocator.deallocate(tp, 1);
-            }
-            temp = node->data;
-            node = node->next;
-        }
+        unique([](const value_type& a, const value_type& b) { return a == b; });
     }
 
     template <class BinaryPredicate>
     void unique(BinaryPredicate pred){
-        ListNode<T>* node = head->next->next;
-        T temp = head->next->data;
-        while(node != tail){
-            if(pred(temp, node->data)){
-                ListNode<T>* tp = node;
-                node = node->prev;
-                tp->prev->next = tp->next;
-                tp->next->prev = tp->prev;
-                allocator.destroy(tp);
-                allocator.deallocate(tp, 1);
-            }
-            temp = node->data;
-            node = node->next;
-        }
-    }
-
-private:
-
-    // 分割链表，返回分割后的下一个块起始节点
-    ListNode<T>* split(ListNode<T>* start, size_t blockSize) {
-        ListNode<T>* prev = nullptr;
-        for (size_t i = 0; i < blockSize && start != tail; ++i) {
-            prev = start;
-            start = start->next;
-        }
-        // 不再修改原链表，仅返回下一个块的起始节点
-        return start;
-    }
-        // 合并两个有序块
-    // 合并两个有序块到临时链表
-    void mergeToTemp(List<T>& tempList, 
-                    ListNode<T>* left, ListNode<T>* leftEnd,
-                    ListNode<T>* right, ListNode<T>* rightEnd) {
-        ListNode<T>* tempTail = tempList.tail->prev;
-
-        // 合并时创建新节点，而非移动原链表节点
-        while (left != leftEnd && right != rightEnd) {
-            if (left->data <= right->data) {
-                tempList.push_back(left->data);
-                left = left->next;
+        if (size_ < 2) return;
+        ListNodeBase* kept = head.next;
+        ListNodeBase* node = kept->next;
+        while(node != &tail){
+            ListNodeBase* next = node->next;
+            if(pred(value_of(kept), value_of(node))){
+                unlink(node);
+                destroy_node(node);
             } else {
-                tempList.push_back(right->data);
-                right = right->next;
+                kept = node;
             }
+            node = next;
         }
-
-        // 处理剩余节点
-        while (left != leftEnd) {
-            tempList.push_back(left->data);
-            left = left->next;
-        }
-        while (right != rightEnd) {
-            tempList.push_back(right->data);
-            right = right->next;
-        }
-    }
-
-    // 辅助函数：将节点链接到目标尾部
-    void linkNode(ListNode<T>*& destTail, ListNode<T>* node) {
-        node->prev = destTail;
-        node->next = destTail->next;
-        destTail->next->prev = node;
-        destTail->next = node;
     }
 };
 
-#endif //LIST_H
\ No newline at end of file
+#endif //LIST_H
@@ -7,16 +7,19 @@
 #include <initializer_list>
 #include <tuple>
 #include "rb_tree.h"
+#include "btree.h"
 #include "allocator.h"
 
+// Tree 选择底层实现：Rb_tree_policy（默认）或 Btree_policy；
+// 后者的迭代器与引用在插入、删除后失效，且不提供 nth / rank / distance
 template <typename Key, typename Value, typename Compare = less<Key>,
-          typename Alloc = Allocator<pair<const Key, Value>>>
+          typename Alloc = Allocator<pair<const Key, Value>>, typename Tree = Rb_tree_policy>
 class Map{
 
 private:
     using value_type      = std::pair<const Key, Value>;
     using Pair_alloc_type = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<value_type>::other;
-    using Rep_type        = Rb_tree<Key, value_type, _Select1st<value_type>, Compare, Pair_alloc_type>;
+    using Rep_type        = typename Tree::template Rep<Key, value_type, _Select1st<value_type>, Compare, Pair_alloc_type>;
     using Alloc_traits    = __gnu_cxx::__alloc_traits<Pair_alloc_type>;
 
     Rep_type M_t;
@@ -28,7 +31,7 @@ private:
 public:
 
     class value_compare {
-        friend class Map<Key, Value, Compare, Alloc>;
+        friend class Map<Key, Value, Compare, Alloc, Tree>;
     protected:
         Compare comp;
 
@@ -59,6 +62,8 @@ public:
 
     explicit Map(const Compare& Comp, const allocator_type& a = allocator_type()) : M_t(Comp, Pair_alloc_type(a)) {}
 
+    explicit Map(const allocator_type& a) : M_t(Pair_alloc_type(a)) {}
+
     Map(const Map& Right) = default;
 
     Map(Map&& Right) = default;
@@ -79,6 +84,20 @@ public:
         M_t.M_insert_range_unique(First, Last); 
     }
 
+    // 输入已按键有序且键互不相同：线性时间建树
+    template <class InputIterator>
+    Map(sorted_unique_t, InputIterator First, InputIterator Last, const Compare& Comp = Compare(),
+        const allocator_type& a = allocator_type())
+     : M_t(Comp, Pair_alloc_type(a)) {
+        M_t.M_insert_range_sorted_unique(First, Last);
+    }
+
+    Map(sorted_unique_t, initializer_list<value_type> IList, const Compare& Comp = Compare(),
+        const allocator_type& a = allocator_type())
+     : M_t(Comp, Pair_alloc_type(a)) {
+        M_t.M_insert_range_sorted_unique(IList.begin(), IList.end());
+    }
+
     mapped_type& at(const key_type& key){
         iterator i = lower_bound(key);
 	    if (i == end() || key_comp()(key, (*i).first)){
@@ -151,6 +170,25 @@ public:
         return M_t.find(key) == M_t.end() ? 0 : 1;
     }
 
+    // 顺序统计：按键序第 k 个元素（从 0 开始），越界返回 end()
+    iterator nth(size_type k) noexcept {
+        return M_t.nth(k);
+    }
+
+    const_iterator nth(size_type k) const noexcept {
+        return M_t.nth(k);
+    }
+
+    // 键小于 key 的元素个数
+    size_type rank(const Key& key) const {
+        return M_t.rank(key);
+    }
+
+    // O(log n) 的迭代器距离
+    difference_type distance(const_iterator first, const_iterator last) const noexcept {
+        return M_t.distance(first, last);
+    }
+
     template <class... Args>
     pair<iterator, bool> emplace(Args&&... args){
         if constexpr (sizeof...(Args) == 2){
@@ -0,0 +1,197 @@
+#ifndef MMAP_ALLOCATOR_H
+#define MMAP_ALLOCATOR_H
+
+#include "allocator.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// 大缓冲区直接向内核映射的分配器，配合 Vector 使用：Vector<T, Mmap_allocator<T>>。
+// 不小于 Threshold 字节的请求用匿名 mmap，扩容时 mremap 只改页表、不拷贝数据，
+// 也不会像“新分配 + 拷贝 + 释放”那样短时间占用两倍内存；
+// HugePages 为 true 时对映射区 madvise(MADV_HUGEPAGE)，由透明大页减少 TLB 缺失。
+// 小于 Threshold 的请求仍走 operator new。deallocate 依据 n 判断走哪条路径，
+// 所以必须传入与分配时相同的 n（Vector 传的是容量）。非 Linux 平台全部走 operator new
+template <typename T, size_t Threshold = (size_t(4) << 20), bool HugePages = true>
+class Mmap_allocator{
+public:
+    using value_type = T;
+    // 定义传播特性
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    Mmap_allocator() = default;
+
+    // 支持 rebind
+    template <typename U>
+    struct rebind {
+        using other = Mmap_allocator<U, Threshold, HugePages>;
+    };
+
+    template<typename U>
+    Mmap_allocator(const Mmap_allocator<U, Threshold, HugePages>&) noexcept {}
+
+    //分配内存
+    T* allocate(size_t n) const {
+        size_t bytes = n * sizeof(T);
+        if (S_mapped(bytes)) {
+            return static_cast<T*>(S_map(bytes));
+        }
+        return static_cast<T*>(operator new(bytes));
+    }
+
+    //释放内存
+    void deallocate(T* p, size_t n) const noexcept {
+        size_t bytes = n * sizeof(T);
+        if (S_mapped(bytes)) {
+            S_unmap(p, bytes);
+        } else {
+            operator delete(p);
+        }
+    }
+
+    // 伸缩到 new_n 个元素，保留前 min(old_n, new_n) 个元素的字节。
+    // 新旧都是映射区时用 mremap 原地扩展或由内核挪动页表，否则新分配后拷贝
+    T* reallocate(T* p, size_t old_n, size_t new_n) const {
+        size_t old_bytes = old_n * sizeof(T);
+        size_t new_bytes = new_n * sizeof(T);
+#if defined(__linux__)
+        if (p && S_mapped(old_bytes) && S_mapped(new_bytes)) {
+            void* q = S_remap(p, S_map_length(old_bytes), S_map_length(new_bytes));
+            S_advise(q, S_map_length(new_bytes));
+            return static_cast<T*>(q);
+        }
+#endif
+        T* q = allocate(new_n);
+        if (p) {
+            std::memcpy(static_cast<void*>(q), static_cast<const void*>(p), std::min(old_bytes, new_bytes));
+        }
+        deallocate(p, old_n);
+        return q;
+    }
+
+    //构造对象
+    template <typename... Args>
+    void construct(T* p, Args&&... args) const {
+        new(p) T(forward<Args>(args)...);
+    }
+
+    //销毁对象
+    void destroy(T* p) const {
+        p->~T();
+    }
+
+    // 比较操作：内存来源只取决于大小，任意两个实例都可以互相释放
+    template <typename U>
+    bool operator==(const Mmap_allocator<U, Threshold, HugePages>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const Mmap_allocator<U, Threshold, HugePages>&) const noexcept { return false; }
+
+private:
+    static constexpr size_t S_huge_page = size_t(2) << 20;
+
+    static bool S_mapped(size_t bytes) noexcept {
+#if defined(__linux__)
+        return bytes != 0 && bytes >= Threshold;
+#else
+        return false;
+#endif
+    }
+
+#if defined(__linux__)
+    // 映射长度：按页取整；使用大页时按 2MB 取整。配合 S_map_aligned 让起点也按 2MB 对齐，
+    // 整个映射区由完整的 2MB 区间组成，每一段都可以由透明大页支撑
+    static size_t S_map_length(size_t bytes) noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t unit = HugePages && bytes >= S_huge_page ? S_huge_page : page;
+        return (bytes + unit - 1) / unit * unit;
+    }
+
+    static void S_advise(void* p, size_t length) noexcept {
+#if defined(MADV_HUGEPAGE)
+        if (HugePages) {
+            madvise(p, length, MADV_HUGEPAGE);    // 只是建议，内核不支持时忽略
+        }
+#endif
+    }
+
+    static bool S_huge_aligned(size_t length) noexcept {
+        return HugePages && length >= S_huge_page;
+    }
+
+    // 映射 length 字节的匿名内存。使用大页时 mmap 只保证按普通页对齐，
+    // 所以多映射 2MB，再把首尾多出的部分解除映射，留下起点按 2MB 对齐的 length 字节
+    static void* S_map_aligned(size_t length) {
+        size_t extra = S_huge_aligned(length) ? S_huge_page : 0;
+        void* raw = mmap(nullptr, length + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        if (extra == 0) {
+            return raw;
+        }
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (start + S_huge_page - 1) & ~uintptr_t(S_huge_page - 1);
+        if (aligned > start) {
+            munmap(raw, aligned - start);
+        }
+        size_t tail = start + length + extra - (aligned + length);
+        if (tail) {
+            munmap(reinterpret_cast<void*>(aligned + length), tail);
+        }
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    static void* S_map(size_t bytes) {
+        size_t length = S_map_length(bytes);
+        void* p = S_map_aligned(length);
+        S_advise(p, length);
+        return p;
+    }
+
+    // 伸缩映射区：先尝试原地伸缩；需要挪动时，使用大页则先占好一块 2MB 对齐的区域，
+    // 再用 MREMAP_FIXED 把页表挪过去，避免内核挑一个不对齐的地址
+    static void* S_remap(void* p, size_t old_length, size_t new_length) {
+        void* q = mremap(p, old_length, new_length, 0);
+        if (q != MAP_FAILED) {
+            return q;
+        }
+        if (S_huge_aligned(new_length)) {
+            void* target = S_map_aligned(new_length);
+            q = mremap(p, old_length, new_length, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+            if (q == MAP_FAILED) {
+                munmap(target, new_length);
+                throw std::bad_alloc();
+            }
+            return q;
+        }
+        q = mremap(p, old_length, new_length, MREMAP_MAYMOVE);
+        if (q == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return q;
+    }
+
+    static void S_unmap(void* p, size_t bytes) noexcept {
+        munmap(p, S_map_length(bytes));
+    }
+#else
+    static void* S_map(size_t bytes) {
+        return operator new(bytes);
+    }
+
+    static void S_unmap(void* p, size_t) noexcept {
+        operator delete(p);
+    }
+#endif
+};
+
+#endif // MMAP_ALLOCATOR_H
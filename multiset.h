@@ -6,7 +6,7 @@
 #include "rb_tree.h"
 #include "set.h"
 
-template <typename Key, typename Compare, typename Alloc>
+template <typename Key, typename Compare, typename Alloc, typename Tree>
 class Set;
 
 template <typename Key, typename Compare = std::less<Key>, typename Alloc = Allocator<Key>>
@@ -58,6 +58,20 @@ public:
         M_t.M_insert_range_equal(first, last);
     }
 
+    // 输入已按键有序：线性时间建树
+    template <typename InputIterator>
+    Multiset(sorted_equivalent_t, InputIterator first, InputIterator last, const Compare &comp = Compare(),
+             const allocator_type &a = allocator_type())
+        : M_t(comp, Key_alloc_type(a)){
+        M_t.M_insert_range_sorted_equal(first, last);
+    }
+
+    Multiset(sorted_equivalent_t, initializer_list<value_type> l, const Compare &comp = Compare(),
+             const allocator_type &a = allocator_type())
+        : M_t(comp, Key_alloc_type(a)){
+        M_t.M_insert_range_sorted_equal(l.begin(), l.end());
+    }
+
     Multiset(const Multiset &) = default;
 
     Multiset(Multiset &&) = default;
@@ -259,6 +273,25 @@ public:
         return M_t.count(x);
     }
 
+    // 顺序统计：第 k 小的元素（从 0 开始），越界返回 end()
+    iterator nth(size_type k) noexcept {
+        return M_t.nth(k);
+    }
+
+    const_iterator nth(size_type k) const noexcept {
+        return M_t.nth(k);
+    }
+
+    // 小于 x 的元素个数（第一个等于 x 的元素的下标）
+    size_type rank(const key_type &x) const {
+        return M_t.rank(x);
+    }
+
+    // O(log n) 的迭代器距离
+    difference_type distance(const_iterator first, const_iterator last) const noexcept {
+        return M_t.distance(first, last);
+    }
+
     template <typename Kt>
     auto count(const Kt &x) const -> decltype(M_t.M_count_tr(x)) {
         return M_t.M_count_tr(x);
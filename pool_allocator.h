@@ -0,0 +1,207 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include "allocator.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <cstddef>
+
+// 内存池参数：按 16 字节粒度划分大小类，超过 512 字节的请求直接交给 operator new
+struct Pool_config{
+    static constexpr size_t S_align       = 16;                   // 大小类粒度（同时是块的对齐）
+    static constexpr size_t S_max_bytes   = 512;                  // 池化的最大块大小
+    static constexpr size_t S_class_count = S_max_bytes / S_align;
+    static constexpr size_t S_slab_bytes  = 64 * 1024;            // 每次补充的 slab 大小
+
+    // 字节数 -> 大小类下标
+    static constexpr size_t S_index(size_t bytes) noexcept {
+        return bytes == 0 ? 0 : (bytes - 1) / S_align;
+    }
+
+    // 大小类下标 -> 块大小
+    static constexpr size_t S_class_bytes(size_t index) noexcept {
+        return (index + 1) * S_align;
+    }
+};
+
+// 空闲块直接复用块内存存放链表指针
+struct Pool_free_node{
+    Pool_free_node* M_next;
+};
+
+// 所有线程共享的部分：slab 链（保持可达，进程结束前不归还）和线程退出时留下的空闲块
+class Pool_depot{
+public:
+    static Pool_depot& S_instance(){
+        static Pool_depot depot;
+        return depot;
+    }
+
+    // 从 depot 取走某个大小类的整条空闲链，没有则返回 nullptr
+    Pool_free_node* M_take(size_t index){
+        std::lock_guard<std::mutex> lock(M_mutex);
+        Pool_free_node* chain = M_heads[index];
+        M_heads[index] = nullptr;
+        return chain;
+    }
+
+    // 线程退出时把剩余的空闲链交回 depot
+    void M_give(size_t index, Pool_free_node* first, Pool_free_node* last){
+        std::lock_guard<std::mutex> lock(M_mutex);
+        last->M_next = M_heads[index];
+        M_heads[index] = first;
+    }
+
+    // 申请一块新的 slab，并挂到全局 slab 链上
+    char* M_new_slab(){
+        char* slab = static_cast<char*>(operator new(Pool_config::S_slab_bytes));
+        Slab_header* header = reinterpret_cast<Slab_header*>(slab);
+        header->M_next = M_slabs.load(std::memory_order_relaxed);
+        while (!M_slabs.compare_exchange_weak(header->M_next, header, std::memory_order_release,
+                                              std::memory_order_relaxed)) {}
+        return slab + S_header_bytes;
+    }
+
+    static constexpr size_t S_header_bytes = Pool_config::S_align;
+
+private:
+    struct Slab_header{
+        Slab_header* M_next;
+    };
+
+    Pool_depot() = default;
+
+    std::mutex                 M_mutex;
+    Pool_free_node*            M_heads[Pool_config::S_class_count] = {};
+    std::atomic<Slab_header*>  M_slabs{nullptr};
+};
+
+// 每个线程一组按大小类划分的空闲链表，分配与释放在无竞争时不加锁
+class Pool_free_lists{
+public:
+    static Pool_free_lists& S_local(){
+        thread_local Pool_free_lists lists;
+        return lists;
+    }
+
+    void* M_allocate(size_t bytes){
+        size_t index = Pool_config::S_index(bytes);
+        if (M_heads[index] == nullptr) {
+            M_refill(index);
+        }
+        Pool_free_node* node = M_heads[index];
+        M_heads[index] = node->M_next;
+        return node;
+    }
+
+    void M_deallocate(void* p, size_t bytes) noexcept {
+        size_t index = Pool_config::S_index(bytes);
+        Pool_free_node* node = static_cast<Pool_free_node*>(p);
+        node->M_next = M_heads[index];
+        M_heads[index] = node;
+    }
+
+    ~Pool_free_lists(){
+        for (size_t i = 0; i < Pool_config::S_class_count; ++i) {
+            Pool_free_node* first = M_heads[i];
+            if (first == nullptr) continue;
+            Pool_free_node* last = first;
+            while (last->M_next) last = last->M_next;
+            Pool_depot::S_instance().M_give(i, first, last);
+        }
+    }
+
+private:
+    Pool_free_lists() = default;
+
+    // 优先回收其他线程退出时留下的空闲块，否则切分一块新 slab
+    void M_refill(size_t index){
+        Pool_depot& depot = Pool_depot::S_instance();
+        if ((M_heads[index] = depot.M_take(index)) != nullptr) {
+            return;
+        }
+
+        size_t block = Pool_config::S_class_bytes(index);
+        size_t count = (Pool_config::S_slab_bytes - Pool_depot::S_header_bytes) / block;
+        char* base = depot.M_new_slab();
+        Pool_free_node* head = nullptr;
+        for (size_t i = count; i > 0; --i) {
+            Pool_free_node* node = reinterpret_cast<Pool_free_node*>(base + (i - 1) * block);
+            node->M_next = head;
+            head = node;
+        }
+        M_heads[index] = head;
+    }
+
+    Pool_free_node* M_heads[Pool_config::S_class_count] = {};
+};
+
+// 池化分配器：小对象从线程本地的大小类空闲链表分配，接口与 Allocator<T> 相同，
+// 可以作为任意容器的 Alloc 参数。deallocate 依赖正确的 n 找回大小类。
+template <typename T>
+class Pool_allocator{
+public:
+    using value_type = T;
+    // 定义传播特性
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    Pool_allocator() = default;
+
+    // 支持 rebind
+    template <typename U>
+    struct rebind {
+        using other = Pool_allocator<U>;
+    };
+
+    template<typename U>
+    Pool_allocator(const Pool_allocator<U>&) noexcept {}
+
+    //分配内存
+    T* allocate(size_t n) const {
+        size_t bytes = n * sizeof(T);
+        if (S_pooled(bytes)) {
+            return static_cast<T*>(Pool_free_lists::S_local().M_allocate(bytes));
+        }
+        return static_cast<T*>(operator new(bytes));
+    }
+
+    //释放内存
+    void deallocate(T* p, size_t n) const noexcept {
+        if (p == nullptr) return;
+        size_t bytes = n * sizeof(T);
+        if (S_pooled(bytes)) {
+            Pool_free_lists::S_local().M_deallocate(p, bytes);
+        }
+        else {
+            operator delete(p);
+        }
+    }
+
+    //构造对象
+    template <typename... Args>
+    void construct(T* p, Args&&... args) const {
+        new(p) T(forward<Args>(args)...);
+    }
+
+    //销毁对象
+    void destroy(T* p) const {
+        p->~T();
+    }
+
+    // 比较操作
+    template <typename U>
+    bool operator==(const Pool_allocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const Pool_allocator<U>&) const noexcept { return false; }
+
+private:
+    static constexpr bool S_pooled(size_t bytes) noexcept {
+        return bytes != 0 && bytes <= Pool_config::S_max_bytes && alignof(T) <= Pool_config::S_align;
+    }
+};
+
+#endif // POOL_ALLOCATOR_H
@@ -140,46 +140,85 @@ void swap(Queue<Type, Allocator>& left, Queue<Type, Allocator>& right) noexcept
 
 
 //优先队列
-template<typename T, typename Container = vector<T>, typename Compare = std::less<typename Container::value_type>>
+// Arity 为堆的叉数，默认二叉堆。4 叉 / 8 叉堆的层数更少，一个节点的所有孩子在容器中连续存放，
+// 比较孩子时通常落在同一条缓存行里，大堆上每层少一次缓存缺失
+template<typename T, typename Container = vector<T>, typename Compare = std::less<typename Container::value_type>, size_t Arity = 2>
 class Priority_Queue {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
 private:
     Container c;       // 底层容器
     Compare comp;      // 比较器
 
-    // 上浮操作：将新插入的元素调整到正确位置
+    // 上浮操作：将新插入的元素调整到正确位置。
+    // 把元素取出留下空洞，较小的父节点逐个下移填洞，最后把元素放进空洞，每层只移动一次不交换
     void sift_up(size_t index) {
+        if (index == 0) return;
+        typename Container::value_type value = std::move(c[index]);
         while (index > 0) {
-            size_t parent = (index - 1) / 2;
-            if (comp(c[parent], c[index])) { // 如果父节点小于当前节点
-                std::swap(c[parent], c[index]);
+            size_t parent = (index - 1) / Arity;
+            if (comp(c[parent], value)) { // 如果父节点小于当前元素
+                c[index] = std::move(c[parent]);
                 index = parent;
             } else {
                 break;
             }
         }
+        c[index] = std::move(value);
     }
 
-    // 下沉操作：删除堆顶后调整堆结构
-    void sift_down(size_t index) {
+    // [first, first + Arity) 中未越界的孩子里最大的一个
+    size_t max_child(size_t first, size_t size) const {
+        size_t last = std::min(first + Arity, size);
+        size_t largest = first;
+        for (size_t i = first + 1; i < last; ++i) {
+            if (comp(c[largest], c[i])) {
+                largest = i;
+            }
+        }
+        return largest;
+    }
+
+    // 下沉操作：index 处是空洞，要放入 value。
+    // 自底向上的做法：空洞沿最大孩子一路下移到叶子，不与 value 比较，再从叶子把 value 上浮回来。
+    // value 通常来自堆尾、本就很小，上浮往往只走一两层，比逐层比较 value 少约一半比较次数
+    void sift_down(size_t index, typename Container::value_type value) {
         size_t size = c.size();
-        while (index < size) {
-            size_t left = 2 * index + 1;
-            size_t right = 2 * index + 2;
-            size_t largest = index;
+        size_t top = index;
+        for (;;) {
+            size_t first = index * Arity + 1;
+            if (first >= size) break;
+            size_t child = max_child(first, size);
+            c[index] = std::move(c[child]);
+            index = child;
+        }
+        while (index > top) {
+            size_t parent = (index - 1) / Arity;
+            if (!comp(c[parent], value)) break;
+            c[index] = std::move(c[parent]);
+            index = parent;
+        }
+        c[index] = std::move(value);
+    }
 
-            if (left < size && comp(c[largest], c[left])) {
-                largest = left;
-            }
-            if (right < size && comp(c[largest], c[right])) {
-                largest = right;
-            }
-            if (largest != index) {
-                std::swap(c[index], c[largest]);
-                index = largest;
-            } else {
-                break;
-            }
+    // 自底向上建堆，O(n)
+    void heapify() {
+        size_t size = c.size();
+        if (size < 2) return;
+        for (size_t i = (size - 2) / Arity + 1; i-- > 0; ) {
+            typename Container::value_type value = std::move(c[i]);
+            sift_down(i, std::move(value));
+        }
+    }
+
+    // 含 size 个元素的堆的层数
+    static size_t depth(size_t size) {
+        size_t levels = 0;
+        for (size_t span = 1; size > 0; span *= Arity) {
+            size -= std::min(size, span);
+            ++levels;
         }
+        return levels;
     }
 
     template<typename _Alloc>
@@ -203,12 +242,12 @@ public:
 
     // 带比较器和容器的构造函数
     explicit Priority_Queue(const Compare& cmp, const Container& cont = Container()) : c(cont), comp(cmp) { 
-        std::make_heap(c.begin(), c.end(), comp); 
+        heapify(); 
     }
 
     // 移动语义容器构造函数
     explicit Priority_Queue(const Compare& cmp, Container&& cont) : c(std::move(cont)), comp(cmp) { 
-        std::make_heap(c.begin(), c.end(), comp); 
+        heapify(); 
     }
 
     // 迭代器范围构造函数
@@ -216,7 +255,7 @@ public:
              typename std::iterator_traits<InputIterator>::iterator_category, std::input_iterator_tag>::value>::type>
     Priority_Queue(InputIterator first, InputIterator last, const Compare& cmp = Compare()) : comp(cmp) {
         c.insert(c.end(), first, last);
-        std::make_heap(c.begin(), c.end(), comp);
+        heapify();
     }
 
     // 带分配器的构造函数组
@@ -228,12 +267,12 @@ public:
 
     template<typename Alloc, typename = _Uses<Alloc>>
     Priority_Queue(const Compare& cmp, const Container& cont, const Alloc& alloc) : c(cont, alloc), comp(cmp) { 
-        std::make_heap(c.begin(), c.end(), comp); 
+        heapify(); 
     }
 
     template<typename Alloc, typename = _Uses<Alloc>>
     Priority_Queue(const Compare& cmp, Container&& cont, const Alloc& alloc) : c(std::move(cont), alloc), comp(cmp) { 
-        std::make_heap(c.begin(), c.end(), comp);
+        heapify();
     }
 
     // 拷贝/移动 + 分配器构造函数
@@ -249,7 +288,7 @@ public:
     Priority_Queue(InputIterator first, InputIterator last, const Compare& cmp, Container&& cont, const Alloc& alloc)
         : c(std::move(cont), alloc), comp(cmp) {
         c.insert(c.end(), first, last);
-        std::make_heap(c.begin(), c.end(), comp);
+        heapify();
     }
 
     // 访问堆顶元素（最大元素）
@@ -286,12 +325,44 @@ public:
         sift_up(c.size() - 1);
     }
 
-    // 删除堆顶元素
+    // 删除堆顶元素：堆尾元素填入根部空洞后下沉
     void pop() {
         if (empty()) return;
-        std::swap(c.front(), c.back());
+        typename Container::value_type last = std::move(c.back());
         c.pop_back();
-        sift_down(0);
+        if (!c.empty()) {
+            sift_down(0, std::move(last));
+        }
+    }
+
+    // 批量插入：新增元素与已有元素相比较多时整体重建堆（O(n)），否则逐个上浮
+    template<typename InputIterator>
+    void push_bulk(InputIterator first, InputIterator last) {
+        size_t old_size = c.size();
+        c.insert(c.end(), first, last);
+        size_t added = c.size() - old_size;
+        if (added * depth(c.size()) > c.size()) {
+            heapify();
+        } else {
+            for (size_t i = old_size; i < c.size(); ++i) {
+                sift_up(i);
+            }
+        }
+    }
+
+    // 按优先级从高到低弹出至多 n 个元素写入 out，返回写完后的输出迭代器
+    template<typename OutputIterator>
+    OutputIterator pop_n(size_t n, OutputIterator out) {
+        for (n = std::min(n, c.size()); n > 0; --n) {
+            *out = std::move(c.front());
+            ++out;
+            typename Container::value_type last = std::move(c.back());
+            c.pop_back();
+            if (!c.empty()) {
+                sift_down(0, std::move(last));
+            }
+        }
+        return out;
     }
 
     // 交换两个优先队列
@@ -306,4 +377,261 @@ public:
     }
 };
 
+// 可寻址优先队列：push 返回稳定的句柄，之后可以通过句柄修改优先级或删除元素，
+// 不必像 Priority_Queue 那样重复压入、弹出时再跳过过期项，堆的大小始终等于存活元素个数。
+// 元素存放在单独分配的节点里，堆数组中只保存节点指针，节点记录自己在堆中的位置；
+// 移动节点指针代价固定，与 T 的大小无关。句柄在对应元素被 pop / erase / clear 之前一直有效
+template<typename T, typename Compare = std::less<T>, size_t Arity = 2, typename Alloc = Allocator<T>>
+class Addressable_priority_queue {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+private:
+    struct Node {
+        T      value;
+        size_t pos;     // 在 heap 中的下标
+
+        template<typename... Args>
+        explicit Node(Args&&... args) : value(std::forward<Args>(args)...), pos(0) {}
+    };
+
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+public:
+    using value_type     = T;
+    using size_type      = size_t;
+    using value_compare  = Compare;
+    using allocator_type = Alloc;
+
+    // 元素句柄，默认构造的句柄为空
+    class handle {
+    public:
+        handle() noexcept : node(nullptr) {}
+
+        explicit operator bool() const noexcept {
+            return node != nullptr;
+        }
+
+        bool operator==(const handle& other) const noexcept {
+            return node == other.node;
+        }
+
+        bool operator!=(const handle& other) const noexcept {
+            return node != other.node;
+        }
+
+    private:
+        friend class Addressable_priority_queue;
+        explicit handle(Node* n) noexcept : node(n) {}
+
+        Node* node;
+    };
+
+    explicit Addressable_priority_queue(const Compare& cmp = Compare(), const Alloc& alloc = Alloc())
+        : comp(cmp), allocator(alloc) {}
+
+    Addressable_priority_queue(const Addressable_priority_queue&) = delete;
+    Addressable_priority_queue& operator=(const Addressable_priority_queue&) = delete;
+
+    // 移动后原有句柄仍指向同样的元素，归属于新的队列
+    Addressable_priority_queue(Addressable_priority_queue&& other) noexcept
+        : comp(std::move(other.comp)), allocator(other.allocator) {
+        heap.swap(other.heap);
+    }
+
+    Addressable_priority_queue& operator=(Addressable_priority_queue&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~Addressable_priority_queue() {
+        clear();
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    size_t size() const {
+        return heap.size();
+    }
+
+    void reserve(size_t n) {
+        heap.reserve(n);
+    }
+
+    // 访问堆顶元素（最大元素）
+    const T& top() const {
+        return heap[0]->value;
+    }
+
+    handle top_handle() const {
+        return handle(heap[0]);
+    }
+
+    // 通过句柄读取元素；修改请使用 update / decrease_key
+    const T& value(handle h) const {
+        return h.node->value;
+    }
+
+    handle push(const T& value) {
+        return emplace(value);
+    }
+
+    handle push(T&& value) {
+        return emplace(std::move(value));
+    }
+
+    template<typename... Args>
+    handle emplace(Args&&... args) {
+        Node* node = create_node(std::forward<Args>(args)...);
+        try {
+            heap.push_back(node);
+        } catch (...) {
+            destroy_node(node);
+            throw;
+        }
+        node->pos = heap.size() - 1;
+        sift_up(node->pos);
+        return handle(node);
+    }
+
+    // 删除堆顶元素
+    void pop() {
+        if (empty()) return;
+        remove_at(0);
+    }
+
+    // 删除句柄对应的元素，句柄随之失效
+    void erase(handle h) {
+        remove_at(h.node->pos);
+    }
+
+    // 提升优先级：新值不得比原值优先级更低（默认的 less 下即不小于原值，
+    // 用 greater 组成最小堆时即不大于原值，对应 Dijkstra 中的 decrease-key），只需上浮
+    void decrease_key(handle h, const T& value) {
+        h.node->value = value;
+        sift_up(h.node->pos);
+    }
+
+    void decrease_key(handle h, T&& value) {
+        h.node->value = std::move(value);
+        sift_up(h.node->pos);
+    }
+
+    // 任意修改元素的值，根据新旧值的关系上浮或下沉
+    void update(handle h, const T& value) {
+        T copy(value);
+        update(h, std::move(copy));
+    }
+
+    void update(handle h, T&& value) {
+        Node* node = h.node;
+        bool raised = comp(node->value, value);
+        node->value = std::move(value);
+        if (raised) {
+            sift_up(node->pos);
+        } else {
+            sift_down(node->pos);
+        }
+    }
+
+    // 删除所有元素，所有句柄失效
+    void clear() {
+        for (size_t i = 0; i < heap.size(); ++i) {
+            destroy_node(heap[i]);
+        }
+        heap.clear();
+    }
+
+    void swap(Addressable_priority_queue& other) noexcept {
+        heap.swap(other.heap);
+        std::swap(comp, other.comp);
+        std::swap(allocator, other.allocator);
+    }
+
+    friend void swap(Addressable_priority_queue& lhs, Addressable_priority_queue& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+private:
+    Vector<Node*>  heap;
+    Compare        comp;
+    node_allocator allocator;
+
+    template<typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* node = allocator.allocate(1);
+        try {
+            ::new (static_cast<void*>(node)) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            allocator.deallocate(node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroy_node(Node* node) {
+        node->~Node();
+        allocator.deallocate(node, 1);
+    }
+
+    // 把 node 放到 heap[index] 并更新它记录的位置
+    void place(size_t index, Node* node) {
+        heap[index] = node;
+        node->pos = index;
+    }
+
+    // 与 Priority_Queue 相同的空洞式上浮
+    void sift_up(size_t index) {
+        Node* node = heap[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / Arity;
+            if (!comp(heap[parent]->value, node->value)) break;
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, node);
+    }
+
+    // 自顶向下的下沉：被修改或补位的元素可能落在任意一层，逐层与最大孩子比较
+    void sift_down(size_t index) {
+        Node* node = heap[index];
+        size_t size = heap.size();
+        for (;;) {
+            size_t first = index * Arity + 1;
+            if (first >= size) break;
+            size_t last = std::min(first + Arity, size);
+            size_t largest = first;
+            for (size_t i = first + 1; i < last; ++i) {
+                if (comp(heap[largest]->value, heap[i]->value)) {
+                    largest = i;
+                }
+            }
+            if (!comp(node->value, heap[largest]->value)) break;
+            place(index, heap[largest]);
+            index = largest;
+        }
+        place(index, node);
+    }
+
+    // 删除 heap[index]：用堆尾节点补位，再视补位节点与父节点的关系上浮或下沉
+    void remove_at(size_t index) {
+        Node* victim = heap[index];
+        Node* last = heap.back();
+        heap.pop_back();
+        if (last != victim) {
+            place(index, last);
+            if (index > 0 && comp(heap[(index - 1) / Arity]->value, last->value)) {
+                sift_up(index);
+            } else {
+                sift_down(index);
+            }
+        }
+        destroy_node(victim);
+    }
+};
+
 #endif //QUEUE_H
\ No newline at end of file
@@ -186,11 +186,13 @@ private:
               typename _Compare, typename _ValueAlloc>
     friend class Rb_tree;
 
+    template <typename _Key2, typename _Value2, typename _KeyOfValue,
+              typename _Compare, typename _ValueAlloc>
+    friend class Btree;
+
     template <typename _Key2, typename _Value2, typename _ValueAlloc,
-              typename _ExtractKey, typename _Equal,
-              typename _Hash, typename _RangeHash, typename _Unused,
-              typename _RehashPolicy, typename _Traits>
-    friend class _Hashtable;
+              typename _ExtractKey, typename _Equal, typename _Hash>
+    friend class Hashtable;
 
     /// @endcond
 };
@@ -241,11 +243,13 @@ private:
               typename _Compare, typename _Alloc>
     friend class Rb_tree;
 
+    template <typename _Key, typename _Val, typename _KeyOfValue,
+              typename _Compare, typename _Alloc>
+    friend class Btree;
+
     template <typename _Key2, typename _Value2, typename _ValueAlloc,
-              typename _ExtractKey, typename _Equal,
-              typename _Hash, typename _RangeHash, typename _Unused,
-              typename _RehashPolicy, typename _Traits>
-    friend class _Hashtable;
+              typename _ExtractKey, typename _Equal, typename _Hash>
+    friend class Hashtable;
 };
 
 /// Return type of insert(node_handle&&) on unique maps/sets.
@@ -257,6 +261,13 @@ struct Node_insert_return
     _NodeHandle node;
 };
 
+// 构造标签：声明输入已按键有序，容器可以跳过查找直接线性建树
+struct sorted_unique_t { explicit sorted_unique_t() = default; };          // 有序且键互不相同
+inline constexpr sorted_unique_t sorted_unique{};
+
+struct sorted_equivalent_t { explicit sorted_equivalent_t() = default; };  // 有序，允许重复键
+inline constexpr sorted_equivalent_t sorted_equivalent{};
+
 enum Rb_tree_color { S_red = false, S_black = true }; // 红黑树节点颜色定义
 
 // 红黑树节点基类，不存储具体数据
@@ -269,6 +280,15 @@ struct Rb_tree_node_base{
     Base_ptr        M_parent;   // 父节点指针
     Base_ptr        M_left;     // 左子节点指针
     Base_ptr        M_right;    // 右子节点指针
+    size_t          M_size;     // 以本节点为根的子树中的节点数（顺序统计用，头节点不使用）
+
+    static size_t S_size(Const_Base_ptr x) noexcept {
+      return x ? x->M_size : 0;
+    }
+
+    void M_update_size() noexcept {
+      M_size = 1 + S_size(M_left) + S_size(M_right);
+    }
 
     // 查找子树的最小节点（最左叶子）
     static Base_ptr S_minimum(Base_ptr x){
@@ -372,6 +392,10 @@ void Rb_tree_rotate_left(Rb_tree_node_base* x, Rb_tree_node_base& header) noexce
     
     y->M_left = x;
     x->M_parent = y;
+
+    // 旋转后 y 接管 x 原来的整棵子树
+    y->M_size = x->M_size;
+    x->M_update_size();
 }
  
 void Rb_tree_rotate_right(Rb_tree_node_base* x, Rb_tree_node_base& header) noexcept {
@@ -391,6 +415,9 @@ void Rb_tree_rotate_right(Rb_tree_node_base* x, Rb_tree_node_base& header) noexc
     
     y->M_right = x;
     x->M_parent = y;
+
+    y->M_size = x->M_size;
+    x->M_update_size();
 }
 
 // 插入平衡完整实现 
@@ -408,6 +435,11 @@ void Rb_tree_insert_and_rebalance(bool insert_left, Rb_tree_node_base* x, Rb_tre
     x->M_parent = p;
     x->M_left = x->M_right = nullptr;
     x->M_color = S_red;
+    x->M_size = 1;
+
+    // 新节点的所有祖先子树规模加一
+    for (Rb_tree_node_base* q = p; q != &header; q = q->M_parent)
+        ++q->M_size;
  
     if (insert_left) {
         p->M_left = x;
@@ -464,7 +496,7 @@ void Rb_tree_insert_and_rebalance(bool insert_left, Rb_tree_node_base* x, Rb_tre
 }
  
 // 删除平衡调整函数
-Rb_tree_node_base* Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z, Rb_tree_node_base& header) {
+Rb_tree_node_base* Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z, Rb_tree_node_base& header) noexcept {
     Rb_tree_node_base*& root = header.M_parent;
     Rb_tree_node_base*& leftmost = header.M_left;
     Rb_tree_node_base*& rightmost = header.M_right;
@@ -472,7 +504,7 @@ Rb_tree_node_base* Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z, Rb_tr
     Rb_tree_node_base* x = nullptr;
     Rb_tree_node_base* x_parent = nullptr;
 
-    // 找到替代节点 y
+    // 找到替代节点 y：z 至多一个孩子时为 z 本身，否则为 z 的后继
     if (y->M_left == nullptr)
         x = y->M_right;
     else if (y->M_right == nullptr)
@@ -484,11 +516,14 @@ Rb_tree_node_base* Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z, Rb_tr
         x = y->M_right;
     }
 
+    // y 从原位置摘下，它的所有祖先子树规模减一
+    for (Rb_tree_node_base* q = y->M_parent; q != &header; q = q->M_parent)
+        --q->M_size;
+
     if (y != z) {
-        if (z->M_left) { 
-            z->M_left->M_parent = y; 
-            y->M_left = z->M_left; 
-        } 
+        // 用 y 顶替 z 的位置
+        z->M_left->M_parent = y;
+        y->M_left = z->M_left;
         if (y != z->M_right) {
             x_parent = y->M_parent;
             if (x)
@@ -497,7 +532,7 @@ Rb_tree_node_base* Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z, Rb_tr
             y->M_right = z->M_right;
             z->M_right->M_parent = y;
         } else {
-            x_parent = y->M_parent;
+            x_parent = y;
         }
         if (root == z)
             root = y;
@@ -507,7 +542,8 @@ Rb_tree_node_base* Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z, Rb_tr
             z->M_parent->M_right = y;
         y->M_parent = z->M_parent;
         std::swap(y->M_color, z->M_color);
-        y = z;
+        y->M_size = z->M_size;
+        y = z;      // y 现在指向真正被删除的节点
     } else {
         x_parent = y->M_parent;
         if (x)
@@ -524,73 +560,69 @@ Rb_tree_node_base* Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z, Rb_tr
             rightmost = (z->M_left == nullptr) ? z->M_parent : Rb_tree_node_base::S_maximum(x);
     }
 
-    // 如果 y 是黑色节点，进行平衡调整
-    if (!y->M_color) {
-        while (x != root && (x == nullptr || !x->M_color)) {
+    // 删除的是黑色节点时，x 所在路径少了一个黑节点，需要调整
+    if (y->M_color != S_red) {
+        while (x != root && (x == nullptr || x->M_color == S_black)) {
             if (x == x_parent->M_left) {
                 Rb_tree_node_base* w = x_parent->M_right;
-                if (w && w->M_color) {
-                    w->M_color = S_red;
-                    x_parent->M_color = S_black;
+                if (w->M_color == S_red) {
+                    w->M_color = S_black;
+                    x_parent->M_color = S_red;
                     Rb_tree_rotate_left(x_parent, header);
                     w = x_parent->M_right;
                 }
-                if ((w->M_left == nullptr || w->M_left && !w->M_left->M_color) &&
-                    (w->M_right == nullptr || w->M_right && !w->M_right->M_color)) {
-                    w->M_color = S_black;
+                if ((w->M_left == nullptr || w->M_left->M_color == S_black) &&
+                    (w->M_right == nullptr || w->M_right->M_color == S_black)) {
+                    w->M_color = S_red;
                     x = x_parent;
                     x_parent = x_parent->M_parent;
                 } else {
-                    if ((w->M_right == nullptr || (w->M_right && !w->M_right->M_color))) {
-                        if (w->M_left)
-                            w->M_left->M_color = S_red;
-                        w->M_color = S_black;
+                    if (w->M_right == nullptr || w->M_right->M_color == S_black) {
+                        w->M_left->M_color = S_black;
+                        w->M_color = S_red;
                         Rb_tree_rotate_right(w, header);
                         w = x_parent->M_right;
                     }
                     w->M_color = x_parent->M_color;
-                    x_parent->M_color = S_red;
-                    if (w && w->M_right)
-                        w->M_right->M_color = S_red;
+                    x_parent->M_color = S_black;
+                    if (w->M_right)
+                        w->M_right->M_color = S_black;
                     Rb_tree_rotate_left(x_parent, header);
-                    x = root;
+                    break;
                 }
             } 
             else {
                 Rb_tree_node_base* w = x_parent->M_left;
-                if (w && w->M_color) {
-                    w->M_color = S_red;
-                    x_parent->M_color = S_black;
+                if (w->M_color == S_red) {
+                    w->M_color = S_black;
+                    x_parent->M_color = S_red;
                     Rb_tree_rotate_right(x_parent, header);
                     w = x_parent->M_left;
                 }
-                if ((w->M_right == nullptr || w->M_right && !w->M_right->M_color) && 
-                    (w->M_left == nullptr || w->M_left && !w->M_left->M_color)) {
-                    w->M_color = S_black;
+                if ((w->M_right == nullptr || w->M_right->M_color == S_black) && 
+                    (w->M_left == nullptr || w->M_left->M_color == S_black)) {
+                    w->M_color = S_red;
                     x = x_parent;
                     x_parent = x_parent->M_parent;
                 } else {
-                    if (w->M_left == nullptr || w->M_left && !w->M_left->M_color) {
-                        if (w->M_right && w->M_right)
-                            w->M_right->M_color = S_red;
-                        w->M_color = S_black;
+                    if (w->M_left == nullptr || w->M_left->M_color == S_black) {
+                        w->M_right->M_color = S_black;
+                        w->M_color = S_red;
                         Rb_tree_rotate_left(w, header);
                         w = x_parent->M_left;
                     }
                     w->M_color = x_parent->M_color;
-                    x_parent->M_color = S_red;
-                    if (w->M_left && w->M_left)
-                        w->M_left->M_color = S_red;
+                    x_parent->M_color = S_black;
+                    if (w->M_left)
+                        w->M_left->M_color = S_black;
                     Rb_tree_rotate_right(x_parent, header);
-                    x = root;
+                    break;
                 }
-            
             }
         }
         if (x)
-            x->M_color = S_red;
+            x->M_color = S_black;
     }
-    if (root) root->M_color = S_black;
     return y;
 }
 
@@ -976,6 +1008,7 @@ protected:
 	    tmp->M_color = x->M_color;
 	    tmp->M_left = 0;
 	    tmp->M_right = 0;
+	    tmp->M_size = x->M_size;
 	    return tmp;
 	}
 
@@ -1652,10 +1685,13 @@ public:
 	using same_value_type = is_same<value_type, typename iterator_traits<_Iter>::value_type>;
 
     // 以下是一些范围插入
+    // 空树且输入已按键有序时线性建树，否则逐个插入
     template<typename InputIterator>
 	__enable_if_t<same_value_type<InputIterator>::value>
 	M_insert_range_unique(InputIterator first, InputIterator last) {
 	    Alloc_node an(*this);
+	    if (M_try_build_sorted<true>(first, last, an))
+	        return;
 	    for (; first != last; ++first)
 	    _M_insert_unique_(end(), *first, an);
 	}
@@ -1671,10 +1707,122 @@ public:
 	__enable_if_t<same_value_type<InputIterator>::value>
 	M_insert_range_equal(InputIterator first, InputIterator last) {
 	    Alloc_node an(*this);
+	    if (M_try_build_sorted<false>(first, last, an))
+	        return;
 	    for (; first != last; ++first)
 	    _M_insert_equal_(end(), *first, an);
 	}
 
+    // 调用者保证 [first, last) 已按键有序（_unique 版本还要求键互不相同），用于 sorted_unique / sorted_equivalent 构造
+    template<typename InputIterator>
+	void M_insert_range_sorted_unique(InputIterator first, InputIterator last) {
+	    if constexpr (S_is_forward<InputIterator>) {
+	        if (empty()) {
+	            Alloc_node an(*this);
+	            M_build_sorted<false>(first, last, std::distance(first, last), an);
+	            return;
+	        }
+	    }
+	    for (; first != last; ++first)
+	    _M_emplace_hint_unique(end(), *first);
+	}
+
+    template<typename InputIterator>
+	void M_insert_range_sorted_equal(InputIterator first, InputIterator last) {
+	    if constexpr (S_is_forward<InputIterator>) {
+	        if (empty()) {
+	            Alloc_node an(*this);
+	            M_build_sorted<false>(first, last, std::distance(first, last), an);
+	            return;
+	        }
+	    }
+	    for (; first != last; ++first)
+	    _M_emplace_hint_equal(end(), *first);
+	}
+
+private:
+    template<typename Iter>
+    static constexpr bool S_is_forward =
+        is_base_of_v<forward_iterator_tag, typename iterator_traits<Iter>::iterator_category>;
+
+    // 空树时检查输入是否有序（Unique 时允许相邻重复，建树时跳过），有序则线性建树
+    template<bool Unique, typename InputIterator, typename NodeGen>
+	bool M_try_build_sorted(InputIterator first, InputIterator last, NodeGen& gen) {
+	    if constexpr (S_is_forward<InputIterator>) {
+	        if (!empty() || first == last)
+	            return false;
+	        size_type n = 1;
+	        for (InputIterator prev = first, cur = std::next(first); cur != last; prev = cur, ++cur) {
+	            if (M_impl.M_key_compare(KeyOfValue()(*cur), KeyOfValue()(*prev)))
+	                return false;
+	            if (!Unique || M_impl.M_key_compare(KeyOfValue()(*prev), KeyOfValue()(*cur)))
+	                ++n;
+	        }
+	        M_build_sorted<Unique>(first, last, n, gen);
+	        return true;
+	    }
+	    else {
+	        return false;
+	    }
+	}
+
+    // 由 n 个（去重后）有序元素建立完全平衡的树：按中点递归，
+    // 除最深一层外全部为黑色，最深一层染红，使每条路径的黑高相同
+    template<bool Unique, typename ForwardIterator, typename NodeGen>
+	void M_build_sorted(ForwardIterator first, ForwardIterator last, size_type n, NodeGen& gen) {
+	    if (n == 0)
+	        return;
+	    size_type red_depth = 0;
+	    for (size_type m = n; m > 1; m >>= 1)
+	        ++red_depth;
+	    Link_type root = M_build_subtree<Unique>(first, last, n, 0, red_depth, gen);
+	    root->M_parent = M_end();
+	    M_root() = root;
+	    M_leftmost() = S_minimum(root);
+	    M_rightmost() = S_maximum(root);
+	    M_impl.M_node_count = n;
+	}
+
+    // 中序消费 first，返回子树根；异常时回收本层已建好的节点
+    template<bool Unique, typename ForwardIterator, typename NodeGen>
+	Link_type M_build_subtree(ForwardIterator& first, ForwardIterator last, size_type n,
+	                          size_type depth, size_type red_depth, NodeGen& gen) {
+	    if (n == 0)
+	        return nullptr;
+	    size_type left_n = (n - 1) / 2;
+	    Link_type left = M_build_subtree<Unique>(first, last, left_n, depth + 1, red_depth, gen);
+	    Link_type node;
+	    try {
+	        node = gen(*first);
+	    }
+	    catch(...) {
+	        if (left) M_erase(left);
+	        throw;
+	    }
+	    ForwardIterator taken = first;
+	    ++first;
+	    if constexpr (Unique) {
+	        while (first != last && !M_impl.M_key_compare(KeyOfValue()(*taken), KeyOfValue()(*first)))
+	            ++first;
+	    }
+	    node->M_color = (depth == red_depth && depth != 0) ? S_red : S_black;
+	    node->M_size = n;
+	    node->M_left = left;
+	    node->M_right = nullptr;
+	    if (left) left->M_parent = node;
+	    try {
+	        node->M_right = M_build_subtree<Unique>(first, last, n - 1 - left_n, depth + 1, red_depth, gen);
+	    }
+	    catch(...) {
+	        M_erase(node);
+	        throw;
+	    }
+	    if (node->M_right) node->M_right->M_parent = node;
+	    return node;
+	}
+
+public:
+
     template<typename InputIterator>
 	__enable_if_t<!same_value_type<InputIterator>::value>
 	M_insert_range_equal(InputIterator first, InputIterator last) {
@@ -1744,10 +1892,9 @@ public:
         return (j == end() || M_impl.M_key_compare(k, S_key(j.M_node))) ? end() : j;   
     }
 
+    // 借助子树规模，两次下降即可得到个数，不必逐个遍历等值区间
     size_type count(const key_type& k) const {
-        std::pair<const_iterator, const_iterator> p = equal_range(k);
-        const size_type n = std::distance(p.first, p.second);
-        return n;
+        return M_rank_upper(k) - rank(k);
     }
 
     iterator lower_bound(const key_type& k) { // 下界查找
@@ -1814,6 +1961,87 @@ public:
 	    M_impl.M_reset();
     }
 
+    // 以下是顺序统计相关函数，依赖每个节点维护的子树规模，均为 O(log n)
+    // 中序第 k 个元素（从 0 开始），k >= size() 时返回 end()
+    iterator nth(size_type k) noexcept {
+        return iterator(const_cast<Base_ptr>(M_select(k)));
+    }
+
+    const_iterator nth(size_type k) const noexcept {
+        return const_iterator(M_select(k));
+    }
+
+    // 键小于 k 的元素个数，即 lower_bound(k) 的下标
+    size_type rank(const key_type& k) const {
+        Const_Base_ptr x = M_root();
+        size_type r = 0;
+        while (x != 0) {
+            if (M_impl.M_key_compare(S_key(x), k)) {
+                r += Rb_tree_node_base::S_size(x->M_left) + 1;
+                x = x->M_right;
+            }
+            else {
+                x = x->M_left;
+            }
+        }
+        return r;
+    }
+
+    // 迭代器在中序序列中的下标，end() 的下标为 size()
+    size_type index_of(const_iterator pos) const noexcept {
+        Const_Base_ptr x = pos.M_node;
+        if (x == M_end())
+            return size();
+        size_type r = Rb_tree_node_base::S_size(x->M_left);
+        for (; x != M_root(); x = x->M_parent) {
+            if (x == x->M_parent->M_right)
+                r += Rb_tree_node_base::S_size(x->M_parent->M_left) + 1;
+        }
+        return r;
+    }
+
+    // [first, last) 中的元素个数，first 须不在 last 之后
+    difference_type distance(const_iterator first, const_iterator last) const noexcept {
+        return difference_type(index_of(last)) - difference_type(index_of(first));
+    }
+
+private:
+    Const_Base_ptr M_select(size_type k) const noexcept {
+        Const_Base_ptr x = M_root();
+        while (x != 0) {
+            size_type left = Rb_tree_node_base::S_size(x->M_left);
+            if (k < left) {
+                x = x->M_left;
+            }
+            else if (k == left) {
+                return x;
+            }
+            else {
+                k -= left + 1;
+                x = x->M_right;
+            }
+        }
+        return M_end();
+    }
+
+    // 键不大于 k 的元素个数，即 upper_bound(k) 的下标
+    size_type M_rank_upper(const key_type& k) const {
+        Const_Base_ptr x = M_root();
+        size_type r = 0;
+        while (x != 0) {
+            if (M_impl.M_key_compare(k, S_key(x))) {
+                x = x->M_left;
+            }
+            else {
+                r += Rb_tree_node_base::S_size(x->M_left) + 1;
+                x = x->M_right;
+            }
+        }
+        return r;
+    }
+
+public:
+
     // 以下是透明查找相关函数
     // 允许使用不同类型的键进行查找。提供了查找、统计、下界、上界和等值范围查找的功能
     template<typename Kt, typename Req = __has_is_transparent_t<Compare, Kt>>
@@ -1911,8 +2139,9 @@ public:
 	void M_assign_unique(Iterator first, Iterator last){
         Reuse_or_alloc_node roan(*this);
         M_impl.M_reset();
+        if (M_try_build_sorted<true>(first, last, roan)) return;
         for (; first != last; ++first){
-            M_insert_unique_(end(), *first, roan);
+            _M_insert_unique_(end(), *first, roan);
         }
     }
 
@@ -1920,8 +2149,9 @@ public:
     void M_assign_equal(Iterator first, Iterator last){
         Reuse_or_alloc_node roan(*this);
         M_impl.M_reset();
+        if (M_try_build_sorted<false>(first, last, roan)) return;
         for (; first != last; ++first){
-            M_insert_equal_(end(), *first, roan);
+            _M_insert_equal_(end(), *first, roan);
         }
     }
 
@@ -2173,4 +2403,10 @@ private:
     }
 };
 
+// Map / Set 的 Tree 参数：选择底层的有序树实现，默认为红黑树
+struct Rb_tree_policy{
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+    using Rep = Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>;
+};
+
 #endif //RB_TREE_H
\ No newline at end of file
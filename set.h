@@ -4,12 +4,20 @@
 #include <bits/concept_check.h>
 #include <initializer_list>
 #include "rb_tree.h"
+#include "btree.h"
+
+// multiset.h 与本文件互相包含，Tree 的默认实参放在最先出现的这个声明上
+template<typename Key, typename Compare, typename Alloc, typename Tree = Rb_tree_policy>
+class Set;
+
 #include "multiset.h"
 
 template<typename Key, typename Compare, typename Alloc>
 class Multiset;
 
-template<typename Key, typename Compare = std::less<Key>, typename Alloc = Allocator<Key> >
+// Tree 选择底层实现：Rb_tree_policy（默认）或 Btree_policy；
+// 后者的迭代器在插入、删除后失效，且不提供 nth / rank / distance
+template<typename Key, typename Compare = std::less<Key>, typename Alloc = Allocator<Key>, typename Tree>
 class Set{
 
       static_assert(is_same<typename remove_cv<Key>::type, Key>::value,
@@ -25,7 +33,7 @@ public:
 private:
     using Key_alloc_type = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Key>::other;
 
-    using Rep_type = Rb_tree<key_type, value_type, _Identity<value_type>, key_compare, Key_alloc_type>;
+    using Rep_type = typename Tree::template Rep<key_type, value_type, _Identity<value_type>, key_compare, Key_alloc_type>;
     
     Rep_type M_t;
 
@@ -60,6 +68,20 @@ public:
             M_t.M_insert_range_unique(first, last); 
     }
 
+    // 输入已按键有序且互不相同：线性时间建树
+    template<typename InputIterator>
+	Set(sorted_unique_t, InputIterator first, InputIterator last, const Compare& comp = Compare(),
+	    const allocator_type& a = allocator_type())
+	    : M_t(comp, Key_alloc_type(a)) {
+            M_t.M_insert_range_sorted_unique(first, last);
+    }
+
+    Set(sorted_unique_t, initializer_list<value_type> l, const Compare& comp = Compare(),
+        const allocator_type& a = allocator_type())
+      : M_t(comp, Key_alloc_type(a)) {
+        M_t.M_insert_range_sorted_unique(l.begin(), l.end());
+    }
+
     Set(const Set&) = default;
 
     Set(Set&&) = default;
@@ -165,7 +187,7 @@ public:
 
     template<typename... Args>
 	iterator emplace_hint(const_iterator pos, Args&&... args) {
-	  return M_t.M_emplace_hint_unique(pos, std::forward<Args>(args)...);
+	  return M_t._M_emplace_hint_unique(pos, std::forward<Args>(args)...);
 	}
 
     std::pair<iterator, bool> insert(const value_type& x) {
@@ -216,13 +238,13 @@ public:
 	friend struct Rb_tree_merge_helper;
 
     template<typename Compare1>
-	void merge(Set<Key, Compare1, Alloc>& source) {
+	void merge(Set<Key, Compare1, Alloc, Tree>& source) {
 	    using Merge_helper = Rb_tree_merge_helper<Set, Compare1>;
 	    M_t.M_merge_unique(Merge_helper::S_get_tree(source));
 	}
 
     template<typename Compare1>
-	void merge(Set<Key, Compare1, Alloc>&& source) { 
+	void merge(Set<Key, Compare1, Alloc, Tree>&& source) { 
         merge(source); 
     }
 
@@ -257,6 +279,21 @@ public:
         return M_t.find(x) == M_t.end() ? 0 : 1; 
     }
 
+    // 顺序统计：第 k 小的元素（从 0 开始），越界返回 end()
+    iterator nth(size_type k) const noexcept { 
+        return M_t.nth(k); 
+    }
+
+    // 小于 x 的元素个数
+    size_type rank(const key_type& x) const { 
+        return M_t.rank(x); 
+    }
+
+    // O(log n) 的迭代器距离
+    difference_type distance(const_iterator first, const_iterator last) const noexcept { 
+        return M_t.distance(first, last); 
+    }
+
     template<typename Kt>
 	auto count(const Kt& x) const->decltype(M_t.M_count_tr(x)) { 
         return M_t.M_count_tr(x); 
@@ -334,11 +371,11 @@ public:
         return pair<iterator, iterator>(M_t.M_equal_range_tr(x)); 
     }
 
-    template<typename K1, typename C1, typename A1>
-	friend bool operator==(const Set<K1, C1, A1>&, const Set<K1, C1, A1>&);
+    template<typename K1, typename C1, typename A1, typename T1>
+	friend bool operator==(const Set<K1, C1, A1, T1>&, const Set<K1, C1, A1, T1>&);
 
-    template<typename K1, typename C1, typename A1>
-	friend bool operator<(const Set<K1, C1, A1>&, const Set<K1, C1, A1>&);
+    template<typename K1, typename C1, typename A1, typename T1>
+	friend bool operator<(const Set<K1, C1, A1, T1>&, const Set<K1, C1, A1, T1>&);
 
 };
 
@@ -364,48 +401,48 @@ Set(InputIterator, InputIterator, Allocator)->Set<typename iterator_traits<Input
 template<typename Key, typename Allocator, typename = _RequireAllocator<Allocator>>
 Set(initializer_list<Key>, Allocator)->Set<Key, less<Key>, Allocator>;
 
-template<typename Key, typename Compare, typename Alloc>
-inline bool operator==(const Set<Key, Compare, Alloc>& x, const Set<Key, Compare, Alloc>& y) { 
+template<typename Key, typename Compare, typename Alloc, typename Tree>
+inline bool operator==(const Set<Key, Compare, Alloc, Tree>& x, const Set<Key, Compare, Alloc, Tree>& y) { 
     return x.M_t == y.M_t; 
 }
 
-template<typename Key, typename Compare, typename Alloc>
-inline bool operator<(const Set<Key, Compare, Alloc>& x, const Set<Key, Compare, Alloc>& y) { 
+template<typename Key, typename Compare, typename Alloc, typename Tree>
+inline bool operator<(const Set<Key, Compare, Alloc, Tree>& x, const Set<Key, Compare, Alloc, Tree>& y) { 
     return x.M_t < y.M_t; 
 }
 
-template<typename Key, typename Compare, typename Alloc>
-inline bool operator!=(const Set<Key, Compare, Alloc>& x, const Set<Key, Compare, Alloc>& y) { 
+template<typename Key, typename Compare, typename Alloc, typename Tree>
+inline bool operator!=(const Set<Key, Compare, Alloc, Tree>& x, const Set<Key, Compare, Alloc, Tree>& y) { 
     return !(x == y); 
 }
 
-template<typename Key, typename Compare, typename Alloc>
-inline bool operator>(const Set<Key, Compare, Alloc>& x, const Set<Key, Compare, Alloc>& y) { 
+template<typename Key, typename Compare, typename Alloc, typename Tree>
+inline bool operator>(const Set<Key, Compare, Alloc, Tree>& x, const Set<Key, Compare, Alloc, Tree>& y) { 
     return y < x; 
 }
 
-template<typename Key, typename Compare, typename Alloc>
-inline bool operator<=(const Set<Key, Compare, Alloc>& x, const Set<Key, Compare, Alloc>& y) { 
+template<typename Key, typename Compare, typename Alloc, typename Tree>
+inline bool operator<=(const Set<Key, Compare, Alloc, Tree>& x, const Set<Key, Compare, Alloc, Tree>& y) { 
     return !(y < x); 
 }
 
-template<typename Key, typename Compare, typename Alloc>
-inline bool operator>=(const Set<Key, Compare, Alloc>& x, const Set<Key, Compare, Alloc>& y) { 
+template<typename Key, typename Compare, typename Alloc, typename Tree>
+inline bool operator>=(const Set<Key, Compare, Alloc, Tree>& x, const Set<Key, Compare, Alloc, Tree>& y) { 
     return !(x < y); 
 }
 
-template<typename Key, typename Compare, typename Alloc>
-inline void swap(Set<Key, Compare, Alloc>& x, Set<Key, Compare, Alloc>& y) noexcept(noexcept(x.swap(y))) {
+template<typename Key, typename Compare, typename Alloc, typename Tree>
+inline void swap(Set<Key, Compare, Alloc, Tree>& x, Set<Key, Compare, Alloc, Tree>& y) noexcept(noexcept(x.swap(y))) {
     x.swap(y); 
 }
 
 
-template<typename Val, typename Cmp1, typename Alloc, typename Cmp2>
-struct Rb_tree_merge_helper<Set<Val, Cmp1, Alloc>, Cmp2> {
+template<typename Val, typename Cmp1, typename Alloc, typename Tree, typename Cmp2>
+struct Rb_tree_merge_helper<Set<Val, Cmp1, Alloc, Tree>, Cmp2> {
 private:
-    friend class Set<Val, Cmp1, Alloc>;
+    friend class Set<Val, Cmp1, Alloc, Tree>;
 
-    static auto& S_get_tree(Set<Val, Cmp2, Alloc>& Set) { 
+    static auto& S_get_tree(Set<Val, Cmp2, Alloc, Tree>& Set) { 
         return Set.M_t; 
     }
 
@@ -0,0 +1,257 @@
+#ifndef STRING_SEARCH_H
+#define STRING_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 字节串的子串查找引擎，供 Basic_string 的 find/rfind 使用。
+// 短模式串：按块比较模式串的首字节与末字节，两者同时命中的位置再逐一验证；
+// 长模式串：Boyer-Moore-Horspool，按坏字符表跳跃。
+// 指令集在编译期选择（AVX2 每块 32 字节，SSE2 每块 16 字节，否则退化为标量）。
+struct String_search{
+    static constexpr size_t S_npos = static_cast<size_t>(-1);
+
+    // 模式串长度超过此值时改用 Horspool
+    static constexpr size_t S_long_needle = 32;
+
+    // 在 s[0, n) 中查找 p[0, m) 第一次出现的位置，m 必须大于 0
+    static size_t S_find(const char* s, size_t n, const char* p, size_t m) noexcept {
+        if (m > n) return S_npos;
+        if (m == 1) {
+            const void* r = std::memchr(s, p[0], n);
+            return r ? static_cast<const char*>(r) - s : S_npos;
+        }
+        return m > S_long_needle ? S_find_horspool(s, n, p, m) : S_find_filter(s, n, p, m);
+    }
+
+    // 在 s[0, n) 中查找 p[0, m) 最后一次出现的位置，m 必须大于 0
+    static size_t S_rfind(const char* s, size_t n, const char* p, size_t m) noexcept {
+        if (m > n) return S_npos;
+        return m > S_long_needle ? S_rfind_horspool(s, n, p, m) : S_rfind_filter(s, n, p, m);
+    }
+
+private:
+#if defined(__AVX2__)
+    using Block = __m256i;
+    static constexpr size_t S_width = 32;
+
+    static Block S_splat(char c) noexcept { return _mm256_set1_epi8(c); }
+
+    static Block S_load(const char* p) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    static uint32_t S_match(Block x, Block y) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+    }
+#elif defined(__SSE2__)
+    using Block = __m128i;
+    static constexpr size_t S_width = 16;
+
+    static Block S_splat(char c) noexcept { return _mm_set1_epi8(c); }
+
+    static Block S_load(const char* p) noexcept {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    static uint32_t S_match(Block x, Block y) noexcept {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+    }
+#endif
+
+    static unsigned char S_uc(char c) noexcept {
+        return static_cast<unsigned char>(c);
+    }
+
+    // 首末字节已经匹配，验证中间部分
+    static bool S_verify(const char* s, const char* p, size_t m) noexcept {
+        return m <= 2 || std::memcmp(s + 1, p + 1, m - 2) == 0;
+    }
+
+    static size_t S_find_filter(const char* s, size_t n, const char* p, size_t m) noexcept {
+        size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+        const Block first = S_splat(p[0]);
+        const Block last  = S_splat(p[m - 1]);
+        // 保证第二次加载 s[i+m-1, i+m-1+S_width) 不越界
+        for (; i + m - 1 + S_width <= n; i += S_width) {
+            uint32_t mask = S_match(first, S_load(s + i)) & S_match(last, S_load(s + i + m - 1));
+            while (mask) {
+                size_t pos = i + __builtin_ctz(mask);
+                if (S_verify(s + pos, p, m)) return pos;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; i + m <= n; ++i) {
+            if (s[i] == p[0] && s[i + m - 1] == p[m - 1] && S_verify(s + i, p, m)) return i;
+        }
+        return S_npos;
+    }
+
+    static size_t S_rfind_filter(const char* s, size_t n, const char* p, size_t m) noexcept {
+        size_t end = n - m + 1;    // 候选起点为 [0, end)
+#if defined(__AVX2__) || defined(__SSE2__)
+        const Block first = S_splat(p[0]);
+        const Block last  = S_splat(p[m - 1]);
+        // 从后往前按块处理，块内从高位向低位验证
+        while (end >= S_width) {
+            size_t lo = end - S_width;
+            uint32_t mask = S_match(first, S_load(s + lo)) & S_match(last, S_load(s + lo + m - 1));
+            while (mask) {
+                unsigned bit = 31 - __builtin_clz(mask);
+                if (S_verify(s + lo + bit, p, m)) return lo + bit;
+                mask &= ~(1u << bit);
+            }
+            end = lo;
+        }
+#endif
+        while (end-- > 0) {
+            if (s[end] == p[0] && s[end + m - 1] == p[m - 1] && S_verify(s + end, p, m)) return end;
+        }
+        return S_npos;
+    }
+
+    // 窗口末字节决定跳跃距离：它在模式串（不含最后一个字节）中最后一次出现到末尾的距离
+    static size_t S_find_horspool(const char* s, size_t n, const char* p, size_t m) noexcept {
+        size_t shift[256];
+        for (size_t c = 0; c < 256; ++c) shift[c] = m;
+        for (size_t k = 0; k + 1 < m; ++k) shift[S_uc(p[k])] = m - 1 - k;
+
+        const char last = p[m - 1];
+        for (size_t i = 0; i + m <= n; ) {
+            char c = s[i + m - 1];
+            if (c == last && std::memcmp(s + i, p, m - 1) == 0) return i;
+            i += shift[S_uc(c)];
+        }
+        return S_npos;
+    }
+
+    // 反向 Horspool：窗口首字节决定向前跳跃的距离
+    static size_t S_rfind_horspool(const char* s, size_t n, const char* p, size_t m) noexcept {
+        size_t shift[256];
+        for (size_t c = 0; c < 256; ++c) shift[c] = m;
+        for (size_t k = m - 1; k > 0; --k) shift[S_uc(p[k])] = k;
+
+        const char first = p[0];
+        size_t pos = n - m;
+        while (true) {
+            char c = s[pos];
+            if (c == first && std::memcmp(s + pos + 1, p + 1, m - 1) == 0) return pos;
+            size_t step = shift[S_uc(c)];
+            if (pos < step) return S_npos;
+            pos -= step;
+        }
+    }
+};
+
+// 字符集合（find_first_of 一类函数的参数），用于单字节字符。
+// 标量路径查 256 位的位图；SIMD 路径把字节拆成高低两个 4 位，
+// 以低 4 位查表（pshufb）得到该列在 16 行中的命中位，再用高 4 位选出对应的位，
+// AVX2 每次判断 32 个字节，SSSE3 每次 16 个字节。
+class Char_class{
+public:
+    Char_class(const char* set, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            unsigned char c = static_cast<unsigned char>(set[i]);
+            M_bits[c >> 6] |= uint64_t(1) << (c & 63);
+            unsigned lo = c & 0x0f, hi = c >> 4;
+            unsigned char* rows = hi < 8 ? M_rows_low : M_rows_high;
+            rows[lo] |= static_cast<unsigned char>(1u << (hi & 7));
+            rows[lo + 16] = rows[lo];    // AVX2 的两个 128 位通道各自查表
+        }
+    }
+
+    bool M_contains(char c) const noexcept {
+        unsigned char u = static_cast<unsigned char>(c);
+        return (M_bits[u >> 6] >> (u & 63)) & 1;
+    }
+
+    // s[0, n) 中第一个（in 为 false 时：第一个不）属于集合的位置
+    size_t M_find_first(const char* s, size_t n, bool in) const noexcept {
+        size_t i = 0;
+#if defined(__AVX2__) || defined(__SSSE3__)
+        for (; i + S_width <= n; i += S_width) {
+            uint32_t mask = M_members(s + i);
+            if (!in) mask = ~mask & S_full;
+            if (mask) return i + __builtin_ctz(mask);
+        }
+#endif
+        for (; i < n; ++i) {
+            if (M_contains(s[i]) == in) return i;
+        }
+        return String_search::S_npos;
+    }
+
+    // s[0, n) 中最后一个（in 为 false 时：最后一个不）属于集合的位置
+    size_t M_find_last(const char* s, size_t n, bool in) const noexcept {
+        size_t end = n;
+#if defined(__AVX2__) || defined(__SSSE3__)
+        while (end >= S_width) {
+            size_t lo = end - S_width;
+            uint32_t mask = M_members(s + lo);
+            if (!in) mask = ~mask & S_full;
+            if (mask) return lo + 31 - __builtin_clz(mask);
+            end = lo;
+        }
+#endif
+        while (end-- > 0) {
+            if (M_contains(s[end]) == in) return end;
+        }
+        return String_search::S_npos;
+    }
+
+private:
+#if defined(__AVX2__)
+    static constexpr size_t   S_width = 32;
+    static constexpr uint32_t S_full  = 0xffffffffu;
+
+    // 返回块内属于集合的字节的位掩码
+    uint32_t M_members(const char* p) const noexcept {
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        const __m256i bit    = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        __m256i x    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i lo   = _mm256_and_si256(x, nibble);
+        __m256i hi   = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+        __m256i low  = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(M_rows_low)), lo);
+        __m256i high = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(M_rows_high)), lo);
+        __m256i row  = _mm256_blendv_epi8(low, high, x);     // 最高位为 1 的字节取高 8 行
+        __m256i want = _mm256_shuffle_epi8(bit, hi);
+        __m256i hit  = _mm256_cmpeq_epi8(_mm256_and_si256(row, want), want);
+        return static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+    }
+#elif defined(__SSSE3__)
+    static constexpr size_t   S_width = 16;
+    static constexpr uint32_t S_full  = 0xffffu;
+
+    uint32_t M_members(const char* p) const noexcept {
+        const __m128i nibble = _mm_set1_epi8(0x0f);
+        const __m128i bit    = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        __m128i x    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i lo   = _mm_and_si128(x, nibble);
+        __m128i hi   = _mm_and_si128(_mm_srli_epi16(x, 4), nibble);
+        __m128i low  = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(M_rows_low)), lo);
+        __m128i high = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(M_rows_high)), lo);
+        __m128i sel  = _mm_cmplt_epi8(x, _mm_setzero_si128());   // 最高位为 1 的字节取高 8 行
+        __m128i row  = _mm_or_si128(_mm_andnot_si128(sel, low), _mm_and_si128(sel, high));
+        __m128i want = _mm_shuffle_epi8(bit, hi);
+        __m128i hit  = _mm_cmpeq_epi8(_mm_and_si128(row, want), want);
+        return static_cast<uint32_t>(_mm_movemask_epi8(hit));
+    }
+#endif
+
+    uint64_t      M_bits[4] = {};             // 256 位位图
+    unsigned char M_rows_low[32] = {};        // 高 4 位为 0~7 的行，按低 4 位索引
+    unsigned char M_rows_high[32] = {};       // 高 4 位为 8~15 的行
+};
+
+#endif // STRING_SEARCH_H
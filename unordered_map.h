@@ -0,0 +1,337 @@
+#ifndef UNORDERED_MAP_H
+#define UNORDERED_MAP_H
+
+#include <bits/functexcept.h>
+#include <bits/concept_check.h>
+#include <initializer_list>
+#include <tuple>
+#include "hashtable.h"
+#include "allocator.h"
+
+// 开放寻址哈希映射，接口与 std::unordered_map 对应；
+// 元素直接存放在槽位数组中，插入、删除与扩容都会使迭代器和引用失效
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>,
+          typename Alloc = Allocator<pair<const Key, Value>>>
+class Unordered_map{
+
+public:
+    using key_type        = Key;
+    using mapped_type     = Value;
+    using value_type      = std::pair<const Key, Value>;
+    using hasher          = Hash;
+    using key_equal       = Equal;
+    using allocator_type  = Alloc;
+
+private:
+    using Pair_alloc_type = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<value_type>::other;
+    using Rep_type        = Hashtable<Key, value_type, Pair_alloc_type, _Select1st<value_type>, Equal, Hash>;
+    using Alloc_traits    = __gnu_cxx::__alloc_traits<Pair_alloc_type>;
+
+    Rep_type M_h;
+
+    template<typename, typename, typename, typename, typename>
+    friend class Unordered_map;
+
+public:
+    using pointer            = typename Alloc_traits::pointer;
+    using const_pointer      = typename Alloc_traits::const_pointer;
+    using reference          = typename Alloc_traits::reference;
+    using const_reference    = typename Alloc_traits::const_reference;
+    using iterator           = typename Rep_type::iterator;
+    using const_iterator     = typename Rep_type::const_iterator;
+    using size_type          = typename Rep_type::size_type;
+    using difference_type    = typename Rep_type::difference_type;
+    using node_type          = typename Rep_type::node_type;
+    using insert_return_type = typename Rep_type::insert_return_type;
+
+    Unordered_map() = default;
+
+    explicit Unordered_map(size_type bucket_count, const Hash& hf = Hash(), const Equal& eql = Equal(),
+                           const allocator_type& a = allocator_type())
+        : M_h(bucket_count, hf, eql, Pair_alloc_type(a)) {}
+
+    explicit Unordered_map(const allocator_type& a) : M_h(0, Hash(), Equal(), Pair_alloc_type(a)) {}
+
+    Unordered_map(const Unordered_map&) = default;
+
+    Unordered_map(const Unordered_map& x, const allocator_type& a) : M_h(x.M_h, Pair_alloc_type(a)) {}
+
+    Unordered_map(Unordered_map&&) = default;
+
+    template <class InputIterator>
+    Unordered_map(InputIterator first, InputIterator last, size_type bucket_count = 0, const Hash& hf = Hash(),
+                  const Equal& eql = Equal(), const allocator_type& a = allocator_type())
+        : M_h(bucket_count, hf, eql, Pair_alloc_type(a)) {
+        M_h.M_insert_range_unique(first, last);
+    }
+
+    Unordered_map(initializer_list<value_type> l, size_type bucket_count = 0, const Hash& hf = Hash(),
+                  const Equal& eql = Equal(), const allocator_type& a = allocator_type())
+        : M_h(bucket_count, hf, eql, Pair_alloc_type(a)) {
+        M_h.M_insert_range_unique(l.begin(), l.end());
+    }
+
+    Unordered_map& operator=(const Unordered_map&) = default;
+
+    Unordered_map& operator=(Unordered_map&&) = default;
+
+    Unordered_map& operator=(initializer_list<value_type> l) {
+        M_h.clear();
+        M_h.M_insert_range_unique(l.begin(), l.end());
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(M_h.get_allocator());
+    }
+
+    iterator begin() noexcept {
+        return M_h.begin();
+    }
+
+    const_iterator begin() const noexcept {
+        return M_h.begin();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return M_h.begin();
+    }
+
+    iterator end() noexcept {
+        return M_h.end();
+    }
+
+    const_iterator end() const noexcept {
+        return M_h.end();
+    }
+
+    const_iterator cend() const noexcept {
+        return M_h.end();
+    }
+
+    bool empty() const noexcept {
+        return M_h.empty();
+    }
+
+    size_type size() const noexcept {
+        return M_h.size();
+    }
+
+    size_type max_size() const noexcept {
+        return M_h.max_size();
+    }
+
+    void clear() noexcept {
+        M_h.clear();
+    }
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+        return M_h.M_insert_unique(x);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& x) {
+        return M_h.M_insert_unique(std::move(x));
+    }
+
+    template<typename Pair, typename = enable_if_t<is_constructible_v<value_type, Pair&&>>>
+    std::pair<iterator, bool> insert(Pair&& x) {
+        return M_h.M_emplace_unique(std::forward<Pair>(x));
+    }
+
+    iterator insert(const_iterator, const value_type& x) {
+        return M_h.M_insert_unique(x).first;
+    }
+
+    iterator insert(const_iterator, value_type&& x) {
+        return M_h.M_insert_unique(std::move(x)).first;
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        M_h.M_insert_range_unique(first, last);
+    }
+
+    void insert(initializer_list<value_type> l) {
+        M_h.M_insert_range_unique(l.begin(), l.end());
+    }
+
+    insert_return_type insert(node_type&& nh) {
+        return M_h.M_reinsert_node_unique(std::move(nh));
+    }
+
+    iterator insert(const_iterator, node_type&& nh) {
+        return M_h.M_reinsert_node_unique(std::move(nh)).position;
+    }
+
+    template<typename Obj>
+    std::pair<iterator, bool> insert_or_assign(const key_type& k, Obj&& obj) {
+        auto ret = M_h.M_try_emplace(k, std::forward<Obj>(obj));
+        if (!ret.second) {
+            ret.first->second = std::forward<Obj>(obj);
+        }
+        return ret;
+    }
+
+    template<typename Obj>
+    std::pair<iterator, bool> insert_or_assign(key_type&& k, Obj&& obj) {
+        auto ret = M_h.M_try_emplace(std::move(k), std::forward<Obj>(obj));
+        if (!ret.second) {
+            ret.first->second = std::forward<Obj>(obj);
+        }
+        return ret;
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return M_h.M_emplace_unique(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return M_h.M_emplace_unique(std::forward<Args>(args)...).first;
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+        return M_h.M_try_emplace(k, std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args) {
+        return M_h.M_try_emplace(std::move(k), std::forward<Args>(args)...);
+    }
+
+    iterator erase(const_iterator position) {
+        return M_h.erase(position);
+    }
+
+    iterator erase(iterator position) {
+        return M_h.erase(position);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        return M_h.erase(first, last);
+    }
+
+    size_type erase(const key_type& k) {
+        return M_h.erase(k);
+    }
+
+    void swap(Unordered_map& x) noexcept(noexcept(M_h.swap(x.M_h))) {
+        M_h.swap(x.M_h);
+    }
+
+    node_type extract(const_iterator pos) {
+        __glibcxx_assert(pos != end());
+        return M_h.extract(pos);
+    }
+
+    node_type extract(const key_type& k) {
+        return M_h.extract(k);
+    }
+
+    template<typename Hash1, typename Equal1>
+    void merge(Unordered_map<Key, Value, Hash1, Equal1, Alloc>& source) {
+        M_h.M_merge_unique(source.M_h);
+    }
+
+    template<typename Hash1, typename Equal1>
+    void merge(Unordered_map<Key, Value, Hash1, Equal1, Alloc>&& source) {
+        merge(source);
+    }
+
+    hasher hash_function() const {
+        return M_h.hash_function();
+    }
+
+    key_equal key_eq() const {
+        return M_h.key_eq();
+    }
+
+    iterator find(const key_type& k) {
+        return M_h.find(k);
+    }
+
+    const_iterator find(const key_type& k) const {
+        return M_h.find(k);
+    }
+
+    size_type count(const key_type& k) const {
+        return M_h.count(k);
+    }
+
+    bool contains(const key_type& k) const {
+        return M_h.count(k) != 0;
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& k) {
+        return M_h.equal_range(k);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+        return M_h.equal_range(k);
+    }
+
+    mapped_type& operator[](const key_type& k) {
+        __glibcxx_function_requires(_DefaultConstructibleConcept<mapped_type>)
+        return M_h.M_try_emplace(k).first->second;
+    }
+
+    mapped_type& operator[](key_type&& k) {
+        __glibcxx_function_requires(_DefaultConstructibleConcept<mapped_type>)
+        return M_h.M_try_emplace(std::move(k)).first->second;
+    }
+
+    mapped_type& at(const key_type& k) {
+        iterator i = M_h.find(k);
+        if (i == end()) {
+            __throw_out_of_range(__N("Unordered_map::at"));
+        }
+        return i->second;
+    }
+
+    const mapped_type& at(const key_type& k) const {
+        const_iterator i = M_h.find(k);
+        if (i == end()) {
+            __throw_out_of_range(__N("Unordered_map::at"));
+        }
+        return i->second;
+    }
+
+    // 槽位数即容量
+    size_type bucket_count() const noexcept {
+        return M_h.bucket_count();
+    }
+
+    float load_factor() const noexcept {
+        return M_h.load_factor();
+    }
+
+    float max_load_factor() const noexcept {
+        return M_h.max_load_factor();
+    }
+
+    void rehash(size_type n) {
+        M_h.rehash(n);
+    }
+
+    void reserve(size_type n) {
+        M_h.reserve(n);
+    }
+
+    friend bool operator==(const Unordered_map& x, const Unordered_map& y) {
+        return x.M_h == y.M_h;
+    }
+
+    friend bool operator!=(const Unordered_map& x, const Unordered_map& y) {
+        return !(x == y);
+    }
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+inline void swap(Unordered_map<Key, Value, Hash, Equal, Alloc>& x,
+                 Unordered_map<Key, Value, Hash, Equal, Alloc>& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+}
+
+#endif // UNORDERED_MAP_H
@@ -0,0 +1,257 @@
+#ifndef UNORDERED_SET_H
+#define UNORDERED_SET_H
+
+#include <initializer_list>
+#include "hashtable.h"
+#include "allocator.h"
+
+// 开放寻址哈希集合，接口与 std::unordered_set 对应；
+// 元素直接存放在槽位数组中，插入、删除与扩容都会使迭代器和引用失效
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>,
+          typename Alloc = Allocator<Key>>
+class Unordered_set{
+
+      static_assert(is_same<typename remove_cv<Key>::type, Key>::value,
+	  "Unordered_set must have a non-const, non-volatile value_type");
+
+public:
+    using key_type       = Key;
+    using value_type     = Key;
+    using hasher         = Hash;
+    using key_equal      = Equal;
+    using allocator_type = Alloc;
+
+private:
+    using Key_alloc_type = typename __gnu_cxx::__alloc_traits<Alloc>::template rebind<Key>::other;
+    using Rep_type       = Hashtable<Key, Key, Key_alloc_type, _Identity<Key>, Equal, Hash>;
+    using Alloc_traits   = __gnu_cxx::__alloc_traits<Key_alloc_type>;
+
+    Rep_type M_h;
+
+    template<typename, typename, typename, typename>
+    friend class Unordered_set;
+
+public:
+    using pointer            = typename Alloc_traits::pointer;
+    using const_pointer      = typename Alloc_traits::const_pointer;
+    using reference          = typename Alloc_traits::reference;
+    using const_reference    = typename Alloc_traits::const_reference;
+    using iterator           = typename Rep_type::const_iterator;
+    using const_iterator     = typename Rep_type::const_iterator;
+    using size_type          = typename Rep_type::size_type;
+    using difference_type    = typename Rep_type::difference_type;
+    using node_type          = typename Rep_type::node_type;
+    using insert_return_type = typename Rep_type::insert_return_type;
+
+    Unordered_set() = default;
+
+    explicit Unordered_set(size_type bucket_count, const Hash& hf = Hash(), const Equal& eql = Equal(),
+                           const allocator_type& a = allocator_type())
+        : M_h(bucket_count, hf, eql, Key_alloc_type(a)) {}
+
+    explicit Unordered_set(const allocator_type& a) : M_h(0, Hash(), Equal(), Key_alloc_type(a)) {}
+
+    Unordered_set(const Unordered_set&) = default;
+
+    Unordered_set(const Unordered_set& x, const allocator_type& a) : M_h(x.M_h, Key_alloc_type(a)) {}
+
+    Unordered_set(Unordered_set&&) = default;
+
+    template <class InputIterator>
+    Unordered_set(InputIterator first, InputIterator last, size_type bucket_count = 0, const Hash& hf = Hash(),
+                  const Equal& eql = Equal(), const allocator_type& a = allocator_type())
+        : M_h(bucket_count, hf, eql, Key_alloc_type(a)) {
+        M_h.M_insert_range_unique(first, last);
+    }
+
+    Unordered_set(initializer_list<value_type> l, size_type bucket_count = 0, const Hash& hf = Hash(),
+                  const Equal& eql = Equal(), const allocator_type& a = allocator_type())
+        : M_h(bucket_count, hf, eql, Key_alloc_type(a)) {
+        M_h.M_insert_range_unique(l.begin(), l.end());
+    }
+
+    Unordered_set& operator=(const Unordered_set&) = default;
+
+    Unordered_set& operator=(Unordered_set&&) = default;
+
+    Unordered_set& operator=(initializer_list<value_type> l) {
+        M_h.clear();
+        M_h.M_insert_range_unique(l.begin(), l.end());
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(M_h.get_allocator());
+    }
+
+    iterator begin() const noexcept {
+        return M_h.begin();
+    }
+
+    iterator cbegin() const noexcept {
+        return M_h.begin();
+    }
+
+    iterator end() const noexcept {
+        return M_h.end();
+    }
+
+    iterator cend() const noexcept {
+        return M_h.end();
+    }
+
+    bool empty() const noexcept {
+        return M_h.empty();
+    }
+
+    size_type size() const noexcept {
+        return M_h.size();
+    }
+
+    size_type max_size() const noexcept {
+        return M_h.max_size();
+    }
+
+    void clear() noexcept {
+        M_h.clear();
+    }
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+        return M_h.M_insert_unique(x);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& x) {
+        return M_h.M_insert_unique(std::move(x));
+    }
+
+    iterator insert(const_iterator, const value_type& x) {
+        return M_h.M_insert_unique(x).first;
+    }
+
+    iterator insert(const_iterator, value_type&& x) {
+        return M_h.M_insert_unique(std::move(x)).first;
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        M_h.M_insert_range_unique(first, last);
+    }
+
+    void insert(initializer_list<value_type> l) {
+        M_h.M_insert_range_unique(l.begin(), l.end());
+    }
+
+    insert_return_type insert(node_type&& nh) {
+        return M_h.M_reinsert_node_unique(std::move(nh));
+    }
+
+    iterator insert(const_iterator, node_type&& nh) {
+        return M_h.M_reinsert_node_unique(std::move(nh)).position;
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return M_h.M_emplace_unique(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return M_h.M_emplace_unique(std::forward<Args>(args)...).first;
+    }
+
+    iterator erase(const_iterator position) {
+        return M_h.erase(position);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        return M_h.erase(first, last);
+    }
+
+    size_type erase(const key_type& k) {
+        return M_h.erase(k);
+    }
+
+    void swap(Unordered_set& x) noexcept(noexcept(M_h.swap(x.M_h))) {
+        M_h.swap(x.M_h);
+    }
+
+    node_type extract(const_iterator pos) {
+        __glibcxx_assert(pos != end());
+        return M_h.extract(pos);
+    }
+
+    node_type extract(const key_type& k) {
+        return M_h.extract(k);
+    }
+
+    template<typename Hash1, typename Equal1>
+    void merge(Unordered_set<Key, Hash1, Equal1, Alloc>& source) {
+        M_h.M_merge_unique(source.M_h);
+    }
+
+    template<typename Hash1, typename Equal1>
+    void merge(Unordered_set<Key, Hash1, Equal1, Alloc>&& source) {
+        merge(source);
+    }
+
+    hasher hash_function() const {
+        return M_h.hash_function();
+    }
+
+    key_equal key_eq() const {
+        return M_h.key_eq();
+    }
+
+    iterator find(const key_type& k) const {
+        return M_h.find(k);
+    }
+
+    size_type count(const key_type& k) const {
+        return M_h.count(k);
+    }
+
+    bool contains(const key_type& k) const {
+        return M_h.count(k) != 0;
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& k) const {
+        return M_h.equal_range(k);
+    }
+
+    // 槽位数即容量
+    size_type bucket_count() const noexcept {
+        return M_h.bucket_count();
+    }
+
+    float load_factor() const noexcept {
+        return M_h.load_factor();
+    }
+
+    float max_load_factor() const noexcept {
+        return M_h.max_load_factor();
+    }
+
+    void rehash(size_type n) {
+        M_h.rehash(n);
+    }
+
+    void reserve(size_type n) {
+        M_h.reserve(n);
+    }
+
+    friend bool operator==(const Unordered_set& x, const Unordered_set& y) {
+        return x.M_h == y.M_h;
+    }
+
+    friend bool operator!=(const Unordered_set& x, const Unordered_set& y) {
+        return !(x == y);
+    }
+};
+
+template <typename Key, typename Hash, typename Equal, typename Alloc>
+inline void swap(Unordered_set<Key, Hash, Equal, Alloc>& x,
+                 Unordered_set<Key, Hash, Equal, Alloc>& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+}
+
+#endif // UNORDERED_SET_H
@@ -0,0 +1,743 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include "allocator.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+
+// 节点的链接部分与元素个数；哨兵只有这一部分，嵌在 Unrolled_list 对象里，首尾相连成环
+struct Unrolled_node_base {
+    Unrolled_node_base* prev;
+    Unrolled_node_base* next;
+    size_t count;   // 节点中的元素个数，元素连续存放在 [0, count)
+};
+
+// 节点：链接部分之后是容纳 Capacity 个元素的未初始化存储
+template <typename T, size_t Capacity>
+struct Unrolled_node : Unrolled_node_base {
+    alignas(T) unsigned char storage[Capacity * sizeof(T)];
+
+    T* elements() noexcept {
+        return reinterpret_cast<T*>(storage);
+    }
+};
+
+template <typename T, typename Alloc = Allocator<T>, size_t NodeBytes = 512>
+class Unrolled_list;
+
+// 迭代器：所在节点 + 节点内下标。节点内顺序访问就是数组访问，走到节点末尾才跳到下一个节点
+template <typename T, size_t Capacity, bool IsConst>
+class Unrolled_list_iterator {
+private:
+    using Node = Unrolled_node<T, Capacity>;
+
+    Unrolled_node_base* node;
+    size_t index;
+
+    template <typename U, size_t C, bool OtherConst>
+    friend class Unrolled_list_iterator;
+
+    template <typename U, typename A, size_t B>
+    friend class Unrolled_list;
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::conditional_t<IsConst, const T*, T*>;
+    using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+    Unrolled_list_iterator() : node(nullptr), index(0) {}
+
+    Unrolled_list_iterator(Unrolled_node_base* n, size_t i) : node(n), index(i) {}
+
+    // 非 const 迭代器转换为 const 迭代器
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Unrolled_list_iterator(const Unrolled_list_iterator<T, Capacity, OtherConst>& other)
+        : node(other.node), index(other.index) {}
+
+    reference operator*() const {
+        return static_cast<Node*>(node)->elements()[index];
+    }
+
+    pointer operator->() const {
+        return &**this;
+    }
+
+    Unrolled_list_iterator& operator++() {
+        if (++index == node->count) {
+            node = node->next;
+            index = 0;
+        }
+        return *this;
+    }
+
+    Unrolled_list_iterator operator++(int) {
+        Unrolled_list_iterator temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    Unrolled_list_iterator& operator--() {
+        if (index == 0) {
+            node = node->prev;
+            index = node->count;
+        }
+        --index;
+        return *this;
+    }
+
+    Unrolled_list_iterator operator--(int) {
+        Unrolled_list_iterator temp = *this;
+        --*this;
+        return temp;
+    }
+
+    bool operator==(const Unrolled_list_iterator& other) const {
+        return node == other.node && index == other.index;
+    }
+
+    bool operator!=(const Unrolled_list_iterator& other) const {
+        return !(*this == other);
+    }
+};
+
+// 展开链表：每个节点存放一小段连续的元素（约 NodeBytes 字节，至少 2 个），
+// 顺序遍历大部分时间是在数组里前进，每个节点才有一次指针跳转；for_each_segment 直接按段回调，
+// 循环体可以被编译器向量化。
+// 插入时节点已满就对半分裂，删除后节点不足四分之一时与后继合并，元素密度保持在较高水平。
+// 插入 / 删除只使所在节点（以及分裂、合并涉及的节点）上的迭代器失效；
+// 整表与区间 splice 在节点粒度上完成：必要时在边界处分裂节点，然后直接重新链接节点，
+// 除被分裂的边界节点外元素都不移动，指向它们的迭代器仍然有效
+template <typename T, typename Alloc, size_t NodeBytes>
+class Unrolled_list {
+public:
+    static constexpr size_t S_node_capacity = NodeBytes / sizeof(T) < 2 ? 2 : NodeBytes / sizeof(T);
+
+    using iterator               = Unrolled_list_iterator<T, S_node_capacity, false>;
+    using const_iterator         = Unrolled_list_iterator<T, S_node_capacity, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type         = Alloc;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using difference_type        = std::ptrdiff_t;
+    using value_type             = T;
+    using size_type              = size_t;
+
+private:
+    using Node           = Unrolled_node<T, S_node_capacity>;
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+    Unrolled_node_base sentinel_;
+    size_t size_ = 0;
+    Alloc allocator_;
+    node_allocator node_allocator_;
+
+    static T* elements(Unrolled_node_base* node) noexcept {
+        return static_cast<Node*>(node)->elements();
+    }
+
+    void initialize_sentinel() noexcept {
+        sentinel_.prev = &sentinel_;
+        sentinel_.next = &sentinel_;
+        sentinel_.count = 0;
+    }
+
+    // 分配一个空节点并链接到 where 之前
+    Unrolled_node_base* create_node_before(Unrolled_node_base* where) {
+        Node* node = node_allocator_.allocate(1);
+        node->count = 0;
+        node->prev = where->prev;
+        node->next = where;
+        where->prev->next = node;
+        where->prev = node;
+        return node;
+    }
+
+    // 摘下并释放节点（其中的元素已经销毁或搬走）
+    void free_node(Unrolled_node_base* node) noexcept {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        node_allocator_.deallocate(static_cast<Node*>(node), 1);
+    }
+
+    // 把 src 处 n 个元素搬到未初始化的 dst，之后原位置视为已销毁
+    void relocate(T* dst, T* src, size_t n) {
+        if constexpr (Is_trivially_relocatable_v<T>) {
+            if (n) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                allocator_.construct(dst + i, std::move(src[i]));
+                allocator_.destroy(src + i);
+            }
+        }
+    }
+
+    // 把 node 中 [index, count) 搬到紧跟其后的新节点，返回新节点
+    Unrolled_node_base* split_node(Unrolled_node_base* node, size_t index) {
+        Unrolled_node_base* right = create_node_before(node->next);
+        relocate(elements(right), elements(node) + index, node->count - index);
+        right->count = node->count - index;
+        node->count = index;
+        return right;
+    }
+
+    // 节点元素不足四分之一时，把后继节点的元素并进来（放得下才合并）
+    void maybe_merge_next(Unrolled_node_base* node) {
+        Unrolled_node_base* next = node->next;
+        if (node == &sentinel_ || next == &sentinel_) return;
+        if (node->count >= S_node_capacity / 4) return;
+        if (node->count + next->count > S_node_capacity) return;
+        relocate(elements(node) + node->count, elements(next), next->count);
+        node->count += next->count;
+        free_node(next);
+    }
+
+    // 保证 pos 位于节点边界：pos 在节点中间时分裂，返回位于 pos 处、元素都在其后的节点
+    Unrolled_node_base* split_at(const_iterator pos) {
+        if (pos.index == 0) return pos.node;
+        return split_node(pos.node, pos.index);
+    }
+
+    // 把节点链 [first, last] 链接到 where 之前
+    static void link_nodes_before(Unrolled_node_base* where, Unrolled_node_base* first, Unrolled_node_base* last) noexcept {
+        first->prev = where->prev;
+        last->next = where;
+        where->prev->next = first;
+        where->prev = last;
+    }
+
+    // 在 node 的 index 处构造元素，节点必须未满
+    template <typename... Args>
+    void emplace_in_node(Unrolled_node_base* node, size_t index, Args&&... args) {
+        T* data = elements(node);
+        if (index == node->count) {
+            allocator_.construct(data + index, std::forward<Args>(args)...);
+        } else {
+            T value(std::forward<Args>(args)...);
+            allocator_.construct(data + node->count, std::move(data[node->count - 1]));
+            std::move_backward(data + index, data + node->count - 1, data + node->count);
+            data[index] = std::move(value);
+        }
+        ++node->count;
+        ++size_;
+    }
+
+    // 在 after 之前的节点末尾构造元素，该节点已满（或 after 是第一个节点）时在 after 之前新建节点。
+    // 只在末尾追加，不移动已有元素；返回新元素的位置
+    template <typename... Args>
+    iterator append_before(Unrolled_node_base* after, Args&&... args) {
+        Unrolled_node_base* node = after->prev;
+        if (node == &sentinel_ || node->count == S_node_capacity) {
+            node = create_node_before(after);
+        }
+        size_t index = node->count;
+        try {
+            emplace_in_node(node, index, std::forward<Args>(args)...);
+        } catch (...) {
+            if (node->count == 0) free_node(node);
+            throw;
+        }
+        return iterator(node, index);
+    }
+
+    // 删除 node 中 [index, index + n)，节点变空时释放；返回删除位置之后的元素
+    iterator erase_in_node(Unrolled_node_base* node, size_t index, size_t n) {
+        T* data = elements(node);
+        std::move(data + index + n, data + node->count, data + index);
+        for (size_t i = node->count - n; i < node->count; ++i) {
+            allocator_.destroy(data + i);
+        }
+        node->count -= n;
+        size_ -= n;
+        if (node->count == 0) {
+            Unrolled_node_base* next = node->next;
+            free_node(node);
+            return iterator(next, 0);
+        }
+        maybe_merge_next(node);
+        if (index == node->count) {
+            return iterator(node->next, 0);
+        }
+        return iterator(node, index);
+    }
+
+    void destroy_all() noexcept {
+        Unrolled_node_base* node = sentinel_.next;
+        while (node != &sentinel_) {
+            Unrolled_node_base* next = node->next;
+            if constexpr (!std::is_trivially_destructible<T>::value) {
+                T* data = elements(node);
+                for (size_t i = 0; i < node->count; ++i) {
+                    allocator_.destroy(data + i);
+                }
+            }
+            node_allocator_.deallocate(static_cast<Node*>(node), 1);
+            node = next;
+        }
+        initialize_sentinel();
+        size_ = 0;
+    }
+
+    // 接管 other 的全部节点，other 变为空链表
+    void take_nodes(Unrolled_list& other) noexcept {
+        if (other.empty()) {
+            initialize_sentinel();
+        } else {
+            sentinel_.next = other.sentinel_.next;
+            sentinel_.prev = other.sentinel_.prev;
+            sentinel_.count = 0;
+            sentinel_.next->prev = &sentinel_;
+            sentinel_.prev->next = &sentinel_;
+        }
+        size_ = other.size_;
+        other.initialize_sentinel();
+        other.size_ = 0;
+    }
+
+public:
+    // 默认构造函数，不分配内存
+    Unrolled_list() {
+        initialize_sentinel();
+    }
+
+    // 带分配器的构造函数
+    explicit Unrolled_list(const Alloc& Al) : allocator_(Al), node_allocator_(Al) {
+        initialize_sentinel();
+    }
+
+    // 带元素数量的构造函数
+    explicit Unrolled_list(size_type Count, const Alloc& Al = Alloc()) : Unrolled_list(Al) {
+        resize(Count);
+    }
+
+    // 带元素数量和初始值的构造函数
+    Unrolled_list(size_type Count, const T& Val, const Alloc& Al = Alloc()) : Unrolled_list(Al) {
+        assign(Count, Val);
+    }
+
+    // 迭代器范围构造函数
+    template <class InputIterator,
+              typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+              typename std::iterator_traits<InputIterator>::iterator_category>>>
+    Unrolled_list(InputIterator First, InputIterator Last, const Alloc& Al = Alloc()) : Unrolled_list(Al) {
+        assign(First, Last);
+    }
+
+    // 初始化列表构造函数
+    Unrolled_list(std::initializer_list<T> IList, const Alloc& Al = Alloc()) : Unrolled_list(Al) {
+        assign(IList.begin(), IList.end());
+    }
+
+    // 拷贝构造函数：节点按满载重新排列
+    Unrolled_list(const Unrolled_list& Right) : Unrolled_list(Right.allocator_) {
+        assign(Right.begin(), Right.end());
+    }
+
+    // 移动构造函数：哨兵在对象内部，把 Right 的节点链重新挂到本对象的哨兵上
+    Unrolled_list(Unrolled_list&& Right) noexcept : Unrolled_list(Right.allocator_) {
+        take_nodes(Right);
+    }
+
+    ~Unrolled_list() {
+        destroy_all();
+    }
+
+    Unrolled_list& operator=(const Unrolled_list& Right) {
+        if (this != &Right) {
+            assign(Right.begin(), Right.end());
+        }
+        return *this;
+    }
+
+    Unrolled_list& operator=(Unrolled_list&& Right) noexcept {
+        if (this != &Right) {
+            destroy_all();
+            take_nodes(Right);
+        }
+        return *this;
+    }
+
+    Unrolled_list& operator=(std::initializer_list<T> IList) {
+        assign(IList.begin(), IList.end());
+        return *this;
+    }
+
+    void assign(size_type Count, const T& Val) {
+        clear();
+        for (size_type i = 0; i < Count; ++i) {
+            push_back(Val);
+        }
+    }
+
+    template <class InputIterator,
+              typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+              typename std::iterator_traits<InputIterator>::iterator_category>>>
+    void assign(InputIterator First, InputIterator Last) {
+        clear();
+        for (; First != Last; ++First) {
+            push_back(*First);
+        }
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_;
+    }
+
+    // 迭代器
+    iterator begin() noexcept {
+        return iterator(sentinel_.next, 0);
+    }
+
+    const_iterator begin() const noexcept {
+        return cbegin();
+    }
+
+    iterator end() noexcept {
+        return iterator(&sentinel_, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return cend();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return const_iterator(sentinel_.next, 0);
+    }
+
+    const_iterator cend() const noexcept {
+        return const_iterator(const_cast<Unrolled_node_base*>(&sentinel_), 0);
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    // 容量
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    // 元素访问
+    reference front() {
+        return elements(sentinel_.next)[0];
+    }
+
+    const_reference front() const {
+        return elements(sentinel_.next)[0];
+    }
+
+    reference back() {
+        return elements(sentinel_.prev)[sentinel_.prev->count - 1];
+    }
+
+    const_reference back() const {
+        return elements(sentinel_.prev)[sentinel_.prev->count - 1];
+    }
+
+    // 对每个节点中的连续元素调用 f(first, last)，按顺序遍历全部元素
+    template <typename Function>
+    void for_each_segment(Function f) {
+        for (Unrolled_node_base* node = sentinel_.next; node != &sentinel_; node = node->next) {
+            f(elements(node), elements(node) + node->count);
+        }
+    }
+
+    template <typename Function>
+    void for_each_segment(Function f) const {
+        for (Unrolled_node_base* node = sentinel_.next; node != &sentinel_; node = node->next) {
+            const T* data = elements(node);
+            f(data, data + node->count);
+        }
+    }
+
+    // 修改
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        Unrolled_node_base* node = sentinel_.prev;
+        if (node == &sentinel_ || node->count == S_node_capacity) {
+            node = create_node_before(&sentinel_);
+            try {
+                emplace_in_node(node, 0, std::forward<Args>(args)...);
+            } catch (...) {
+                free_node(node);
+                throw;
+            }
+            return;
+        }
+        emplace_in_node(node, node->count, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        emplace(cbegin(), std::forward<Args>(args)...);
+    }
+
+    void push_back(const T& Val) {
+        emplace_back(Val);
+    }
+
+    void push_back(T&& Val) {
+        emplace_back(std::move(Val));
+    }
+
+    void push_front(const T& Val) {
+        emplace_front(Val);
+    }
+
+    void push_front(T&& Val) {
+        emplace_front(std::move(Val));
+    }
+
+    void pop_back() {
+        if (empty()) return;
+        Unrolled_node_base* node = sentinel_.prev;
+        erase_in_node(node, node->count - 1, 1);
+    }
+
+    void pop_front() {
+        if (empty()) return;
+        erase_in_node(sentinel_.next, 0, 1);
+    }
+
+    // 在 Where 之前构造元素。节点已满时先对半分裂；
+    // Where 位于节点开头时优先放进前一个节点的末尾，不移动任何元素
+    template <typename... Args>
+    iterator emplace(const_iterator Where, Args&&... args) {
+        Unrolled_node_base* node = Where.node;
+        size_t index = Where.index;
+        if (index == 0 && node->prev != &sentinel_ && node->prev->count < S_node_capacity) {
+            node = node->prev;
+            index = node->count;
+        }
+        if (node == &sentinel_) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(sentinel_.prev, sentinel_.prev->count - 1);
+        }
+        if (node->count == S_node_capacity) {
+            T value(std::forward<Args>(args)...);
+            size_t half = S_node_capacity / 2;
+            Unrolled_node_base* right = split_node(node, half);
+            if (index > half) {
+                node = right;
+                index -= half;
+            }
+            emplace_in_node(node, index, std::move(value));
+            return iterator(node, index);
+        }
+        emplace_in_node(node, index, std::forward<Args>(args)...);
+        return iterator(node, index);
+    }
+
+    iterator insert(const_iterator Where, const T& Val) {
+        return emplace(Where, Val);
+    }
+
+    iterator insert(const_iterator Where, T&& Val) {
+        return emplace(Where, std::move(Val));
+    }
+
+    // 批量插入：先把 Where 所在节点在插入点分裂，新元素依次追加到前半段并按需新建节点，
+    // 每个元素只构造一次，不逐个移动插入点之后的元素
+    template <class InputIterator,
+              typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+              typename std::iterator_traits<InputIterator>::iterator_category>>>
+    iterator insert(const_iterator Where, InputIterator First, InputIterator Last) {
+        if (First == Last) return iterator(Where.node, Where.index);
+        Unrolled_node_base* after = split_at(Where);
+        iterator first = append_before(after, *First);
+        for (++First; First != Last; ++First) {
+            append_before(after, *First);
+        }
+        return first;
+    }
+
+    // 与区间插入相同：分裂一次后连续追加，已插入的元素不会再被移动，返回的迭代器保持有效。
+    // Val 可能引用分裂时被搬走的元素，先复制一份
+    iterator insert(const_iterator Where, size_type Count, const T& Val) {
+        if (Count == 0) return iterator(Where.node, Where.index);
+        T value(Val);
+        Unrolled_node_base* after = split_at(Where);
+        iterator first = append_before(after, value);
+        for (size_type i = 1; i < Count; ++i) {
+            append_before(after, value);
+        }
+        return first;
+    }
+
+    iterator insert(const_iterator Where, std::initializer_list<T> IList) {
+        return insert(Where, IList.begin(), IList.end());
+    }
+
+    iterator erase(const_iterator Where) {
+        return erase_in_node(Where.node, Where.index, 1);
+    }
+
+    // 按节点成段删除：每个节点只移动一次剩余元素
+    iterator erase(const_iterator First, const_iterator Last) {
+        size_t n = 0;
+        for (const_iterator it = First; it != Last; ++it) {
+            ++n;
+        }
+        iterator pos(First.node, First.index);
+        while (n > 0) {
+            size_t k = std::min(n, pos.node->count - pos.index);
+            pos = erase_in_node(pos.node, pos.index, k);
+            n -= k;
+        }
+        return pos;
+    }
+
+    void clear() noexcept {
+        destroy_all();
+    }
+
+    void resize(size_type Newsize) {
+        while (size_ > Newsize) {
+            pop_back();
+        }
+        while (size_ < Newsize) {
+            emplace_back();
+        }
+    }
+
+    void resize(size_type Newsize, const T& Val) {
+        while (size_ > Newsize) {
+            pop_back();
+        }
+        while (size_ < Newsize) {
+            push_back(Val);
+        }
+    }
+
+    // 把 Source 的全部元素移到 Where 之前：最多分裂一个节点，其余节点直接重新链接
+    void splice(const_iterator Where, Unrolled_list& Source) {
+        if (this == &Source || Source.empty()) return;
+        Unrolled_node_base* after = split_at(Where);
+        Unrolled_node_base* first = Source.sentinel_.next;
+        Unrolled_node_base* last = Source.sentinel_.prev;
+        size_ += Source.size_;
+        Source.initialize_sentinel();
+        Source.size_ = 0;
+        link_nodes_before(after, first, last);
+    }
+
+    void splice(const_iterator Where, Unrolled_list&& Source) {
+        splice(Where, Source);
+    }
+
+    // 移动单个元素：元素被移动构造到新位置，Iter 失效
+    void splice(const_iterator Where, Unrolled_list& Source, const_iterator Iter) {
+        if (this == &Source) return;
+        emplace(Where, std::move(*iterator(Iter.node, Iter.index)));
+        Source.erase(Iter);
+    }
+
+    void splice(const_iterator Where, Unrolled_list&& Source, const_iterator Iter) {
+        splice(Where, Source, Iter);
+    }
+
+    // 移动区间 [First, Last)：先在 Source 中把区间两端分裂到节点边界，再整段重新链接节点
+    void splice(const_iterator Where, Unrolled_list& Source, const_iterator First, const_iterator Last) {
+        if (this == &Source || First == Last) return;
+        Unrolled_node_base* after = split_at(Where);
+        Unrolled_node_base* stop = Source.split_at(Last);
+        Unrolled_node_base* first = Source.split_at(First);
+        Unrolled_node_base* last = stop->prev;
+        size_t moved = 0;
+        for (Unrolled_node_base* node = first; node != stop; node = node->next) {
+            moved += node->count;
+        }
+        first->prev->next = stop;
+        stop->prev = first->prev;
+        Source.size_ -= moved;
+        size_ += moved;
+        link_nodes_before(after, first, last);
+    }
+
+    void splice(const_iterator Where, Unrolled_list&& Source, const_iterator First, const_iterator Last) {
+        splice(Where, Source, First, Last);
+    }
+
+    void swap(Unrolled_list& Right) noexcept {
+        if (this == &Right) return;
+        Unrolled_list temp(std::move(Right));
+        Right.take_nodes(*this);
+        take_nodes(temp);
+        if constexpr (std::allocator_traits<Alloc>::propagate_on_container_swap::value) {
+            std::swap(allocator_, Right.allocator_);
+            std::swap(node_allocator_, Right.node_allocator_);
+        }
+    }
+};
+
+// 比较运算符
+template <typename T, typename Alloc, size_t B>
+inline bool operator==(const Unrolled_list<T, Alloc, B>& x, const Unrolled_list<T, Alloc, B>& y) {
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+template <typename T, typename Alloc, size_t B>
+inline bool operator!=(const Unrolled_list<T, Alloc, B>& x, const Unrolled_list<T, Alloc, B>& y) {
+    return !(x == y);
+}
+
+template <typename T, typename Alloc, size_t B>
+inline bool operator<(const Unrolled_list<T, Alloc, B>& x, const Unrolled_list<T, Alloc, B>& y) {
+    return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <typename T, typename Alloc, size_t B>
+inline bool operator>(const Unrolled_list<T, Alloc, B>& x, const Unrolled_list<T, Alloc, B>& y) {
+    return y < x;
+}
+
+template <typename T, typename Alloc, size_t B>
+inline bool operator<=(const Unrolled_list<T, Alloc, B>& x, const Unrolled_list<T, Alloc, B>& y) {
+    return !(y < x);
+}
+
+template <typename T, typename Alloc, size_t B>
+inline bool operator>=(const Unrolled_list<T, Alloc, B>& x, const Unrolled_list<T, Alloc, B>& y) {
+    return !(x < y);
+}
+
+template <typename T, typename Alloc, size_t B>
+inline void swap(Unrolled_list<T, Alloc, B>& x, Unrolled_list<T, Alloc, B>& y) noexcept {
+    x.swap(y);
+}
+
+#endif // UNROLLED_LIST_H
@@ -2,12 +2,45 @@
 #define VECTOR_H
 
 #include"allocator.h"
+#include "growth_policy.h"
 #include<iostream>
 #include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
 #include<initializer_list>
 using namespace std;
 
-template <typename T, typename Alloc = Allocator<T>>
+// 可平凡重定位：把对象的字节拷到新地址、且不再对旧地址调用析构，等价于“移动构造 + 析构旧对象”。
+// 平凡可复制的类型自动满足；其他类型可以特化为 true_type 显式声明，
+// 例如只持有堆指针的句柄类。对象内部有指向自身的指针时（如带 SSO 的字符串）不能声明
+template<typename T>
+struct Is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+inline constexpr bool Is_trivially_relocatable_v = Is_trivially_relocatable<T>::value;
+
+template<typename T, typename D>
+struct Is_trivially_relocatable<std::unique_ptr<T, D>> : Is_trivially_relocatable<D> {};
+
+template<typename T>
+struct Is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template<typename T1, typename T2>
+struct Is_trivially_relocatable<std::pair<T1, T2>>
+    : std::bool_constant<Is_trivially_relocatable_v<T1> && Is_trivially_relocatable_v<T2>> {};
+
+// 分配器可以提供 reallocate(p, old_n, new_n)：尽量原地伸缩，必要时搬到新地址（逐字节拷贝），
+// 返回新的缓冲区。p 可以为空。Vector 只在元素可平凡重定位时使用它
+template<typename Alloc, typename = void>
+struct Has_reallocate : std::false_type {};
+
+template<typename Alloc>
+struct Has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+    std::declval<typename Alloc::value_type*>(), size_t(), size_t()))>> : std::true_type {};
+
+// Growth 为扩容策略，见 growth_policy.h
+template <typename T, typename Alloc = Allocator<T>, typename Growth = Growth_double>
 class Vector{
 private:
     T* data_ = nullptr;
@@ -15,11 +48,117 @@ private:
     size_t capacity_ = 0;
     Alloc allocator;
 
-    //辅助函数  用于扩容
+    // 把 n 个元素从 src 搬到未初始化的 dst，之后 src 处视为已销毁。
+    // 可平凡重定位的类型整段 memcpy，不逐个调用移动构造与析构
+    void relocate_elements(T* dst, T* src, size_t n) {
+        if constexpr (Is_trivially_relocatable_v<T>) {
+            if (n) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                allocator.construct(dst + i, std::move(src[i]));
+                allocator.destroy(src + i);
+            }
+        }
+    }
+
+    // 换成容量为 new_capacity 的缓冲区，保留已有元素
+    void reallocate_storage(size_t new_capacity) {
+        if constexpr (Is_trivially_relocatable_v<T> && Has_reallocate<Alloc>::value) {
+            data_ = allocator.reallocate(data_, capacity_, new_capacity);
+        } else {
+            T* new_data = allocator.allocate(new_capacity);
+            relocate_elements(new_data, data_, size_);
+            allocator.deallocate(data_, capacity_);
+            data_ = new_data;
+        }
+        capacity_ = new_capacity;
+    }
+
+    // 在未初始化的 dst 处构造 [first, last) 的 count 个副本
+    template <class ForwardIterator>
+    static void copy_range(T* dst, ForwardIterator first, ForwardIterator last, size_t count) {
+        using Source = typename std::remove_cv<typename std::remove_pointer<ForwardIterator>::type>::type;
+        if constexpr (std::is_pointer<ForwardIterator>::value && std::is_same<Source, T>::value &&
+                      std::is_trivially_copyable<T>::value) {
+            if (count) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(first), count * sizeof(T));
+            }
+        } else {
+            std::uninitialized_copy(first, last, dst);
+        }
+    }
+
+    // 在 offset 处腾出 count 个未初始化的位置（容量必须足够），其后的元素整体后移
+    void open_gap(size_t offset, size_t count) {
+        size_t tail = size_ - offset;
+        if constexpr (Is_trivially_relocatable_v<T>) {
+            if (tail) {
+                std::memmove(static_cast<void*>(data_ + offset + count), static_cast<const void*>(data_ + offset),
+                             tail * sizeof(T));
+            }
+        } else {
+            for (size_t i = tail; i > 0; --i) {
+                allocator.construct(data_ + offset + count + i - 1, std::move(data_[offset + i - 1]));
+                allocator.destroy(data_ + offset + i - 1);
+            }
+        }
+    }
+
+    // open_gap 的逆操作：填充失败时把后移的元素移回原处
+    void close_gap(size_t offset, size_t count) noexcept {
+        size_t tail = size_ - offset;
+        if constexpr (Is_trivially_relocatable_v<T>) {
+            if (tail) {
+                std::memmove(static_cast<void*>(data_ + offset), static_cast<const void*>(data_ + offset + count),
+                             tail * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < tail; ++i) {
+                allocator.construct(data_ + offset + i, std::move(data_[offset + count + i]));
+                allocator.destroy(data_ + offset + count + i);
+            }
+        }
+    }
+
+    // 在 offset 处插入 count 个由 fill(dst) 构造的元素。
+    // 容量不够时一次分配到位：先在新缓冲区构造新元素，再把前后两段搬过去，fill 抛异常时原内容不变
+    template <class Fill>
+    T* insert_with(size_t offset, size_t count, Fill fill) {
+        if (count == 0) {
+            return data_ + offset;
+        }
+        if (size_ + count > capacity_) {
+            size_t new_capacity = Growth::S_grow(capacity_, size_ + count, sizeof(T));
+            T* new_data = allocator.allocate(new_capacity);
+            try {
+                fill(new_data + offset);
+            } catch (...) {
+                allocator.deallocate(new_data, new_capacity);
+                throw;
+            }
+            relocate_elements(new_data, data_, offset);
+            relocate_elements(new_data + offset + count, data_ + offset, size_ - offset);
+            allocator.deallocate(data_, capacity_);
+            data_ = new_data;
+            capacity_ = new_capacity;
+        } else {
+            open_gap(offset, count);
+            try {
+                fill(data_ + offset);
+            } catch (...) {
+                close_gap(offset, count);
+                throw;
+            }
+        }
+        size_ += count;
+        return data_ + offset;
+    }
+
+    //辅助函数  用于扩容：至少容纳 min_capacity 个元素，按 Growth 预留余量
     void expand_capacity(size_t min_capacity = 0) {
-        size_t new_capacity = std::max(capacity_ * 2, min_capacity);
-        if(!new_capacity) new_capacity = 1;
-        reserve(new_capacity);
+        reserve(Growth::S_grow(capacity_, std::max(min_capacity, size_ + 1), sizeof(T)));
     }
 
 public:
@@ -109,10 +248,7 @@ public:
     template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
     Vector(InputIterator first, InputIterator last) : data_(nullptr), size_(0), capacity_(0) {
         try {
-            while (first != last) {
-                push_back(*first);
-                ++first;
-            }
+            append_range(first, last);
         } catch (...) {
             // 若构造过程中抛出异常，释放已分配的内存
             for (size_t i = 0; i < size_; ++i) {
@@ -127,10 +263,7 @@ public:
     template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
     Vector(InputIterator first, InputIterator last, const Alloc& allocator) : data_(nullptr), size_(0), capacity_(0), allocator(allocator) {
         try {
-            while (first != last) {
-                push_back(*first);
-                ++first;
-            }
+            append_range(first, last);
         } catch (...) {
             // 若构造过程中抛出异常，释放已分配的内存
             for (size_t i = 0; i < size_; ++i) {
@@ -147,7 +280,7 @@ public:
         for (size_t i = 0; i < size_; ++i) {
             allocator.destroy(data_ + i);
         }
-        allocator.deallocate(data_, size_);
+        allocator.deallocate(data_, capacity_);
         size_ = other.size_;
         capacity_ = other.capacity_;
         data_ = allocator.allocate(capacity_);
@@ -163,7 +296,7 @@ public:
         for (size_t i = 0; i < size_; ++i) {
             allocator.destroy(data_ + i);
         }
-        allocator.deallocate(data_, size_);
+        allocator.deallocate(data_, capacity_);
         data_ = other.data_;
         size_ = other.size_;
         capacity_ = other.capacity_;
@@ -224,7 +357,9 @@ public:
 
     template <class... Types>
     void emplace_back(Types&&... args){
-        expand_capacity(size_ + sizeof...(args));
+        if(size_ == capacity_){
+            expand_capacity();
+        }
         allocator.construct(data_ + size_, forward<Types>(args)...);
         size_++;
     }
@@ -314,11 +449,10 @@ public:
 
     //从指定位置删除向量中的一个元素或一系列元素
     iterator erase(const_iterator position){
-        size_t pos = position - begin();
-        allocator.destroy(begin() + pos);
-        for(size_t i = pos; i < size_; i++){
-            allocator.construct(data_ + i, *(data_ + i + 1));
-        }
+        size_t pos = position - cbegin();
+        // 后续元素整体前移一位，再析构末尾的空出元素
+        std::move(begin() + pos + 1, end(), begin() + pos);
+        allocator.destroy(data_ + size_ - 1);
         --size_;
         return data_ + pos;
     }
@@ -352,43 +486,41 @@ public:
 
     void assign(initializer_list<value_type> list){
         clear();
-        size_t i = 0;
-		for (const T& element : list) {
-			data_[i++] = element;
-            size_++;
-		}
+        append_range(list.begin(), list.end());
     }
 
     template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
     void assign(InputIterator first, InputIterator last){
         clear();
-        while (first != last) {
-            push_back(*first);
-            ++first;
-        }
+        append_range(first, last);
     }
 
     //将就地构造的元素插入到指定位置的向量中
     template <class... Args>
     iterator emplace(const_iterator pos, Args&&... args) {
         size_t offset = pos - cbegin();
-        if (size_ == capacity_) {
-            expand_capacity(size_ + sizeof...(args)); // 预扩容
+        if (offset == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return begin() + offset;
         }
-        
-        // 批量移动元素（避免逐个移动）
-        if (offset < size_) {
-            std::move_backward(begin() + offset, end(), end() + 1);
+
+        // 参数可能引用容器内的元素，先构造出来再搬移
+        T value(std::forward<Args>(args)...);
+        if (size_ == capacity_) {
+            expand_capacity();
         }
-        
-        allocator.construct(data_ + offset, std::forward<Args>(args)...);
+
+        // 末尾元素移入未初始化的位置，其余元素批量后移
+        allocator.construct(data_ + size_, std::move(data_[size_ - 1]));
+        std::move_backward(begin() + offset, end() - 1, end());
+        data_[offset] = std::move(value);
         ++size_;
         return begin() + offset;
     }
 
     //返回用于构造矢量的分配器对象的一个副本
     allocator_type get_allocator() const{
-        return allocator_type();
+        return allocator;
     }
 
     //insert   左值
@@ -403,57 +535,93 @@ public:
 
     //多个相同值的元素
     iterator insert(const_iterator position, size_type count, const T& value) {
-        size_t offset = position - cbegin();
-        if (size_ + count > capacity) {
-            expand_capacity(size_ + count);
-        }
-
-        // 移动元素为新元素腾出空间
-        if (offset < size_) {
-            std::move_backward(begin() + offset, end(), end() + count);
-        }
-
-        // 批量构造新元素
-        for (size_t i = 0; i < count; ++i) {
-            allocator.construct(data + offset + i, value);
-        }
-
-        size_ += count;
-        return begin() + offset;
+        // value 可能引用容器内的元素，先拷贝一份
+        T copy(value);
+        return insert_with(position - cbegin(), count, [&](T* dst) {
+            std::uninitialized_fill_n(dst, count, copy);
+        });
     }
 
-    template <class InputIterator>
-    void insert(const_iterator position, InputIterator first, InputIterator last) {
-        // 计算插入元素的数量
-        auto count = static_cast<size_t>(std::distance(first, last));
-        if (count == 0) return;
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    iterator insert(const_iterator position, InputIterator first, InputIterator last) {
+        return insert_range(position, first, last);
+    }
 
-        size_t pos = static_cast<size_t>(position - data_);
+    iterator insert(const_iterator position, initializer_list<value_type> list) {
+        return insert_range(position, list.begin(), list.end());
+    }
 
-        size_t newSize = size_ + count;
-        expand_capacity(newSize);
+    // 在末尾追加 [first, last)：前向迭代器先算出长度、只扩容一次，
+    // 平凡可复制的元素从连续内存整段 memcpy；输入迭代器只能逐个追加
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void append_range(InputIterator first, InputIterator last) {
+        using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+        if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+            size_t count = static_cast<size_t>(std::distance(first, last));
+            if (size_ + count > capacity_) {
+                expand_capacity(size_ + count);
+            }
+            copy_range(data_ + size_, first, last, count);
+            size_ += count;
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
 
-        std::move_backward(data_ + pos, data_ + size_, data_ + newSize);
+    // 在 position 处插入 [first, last)，返回指向第一个新元素的迭代器
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    iterator insert_range(const_iterator position, InputIterator first, InputIterator last) {
+        size_t offset = position - cbegin();
+        using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+        if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+            if (offset == size_) {
+                append_range(first, last);
+                return begin() + offset;
+            }
+            size_t count = static_cast<size_t>(std::distance(first, last));
+            return insert_with(offset, count, [&](T* dst) {
+                copy_range(dst, first, last, count);
+            });
+        } else {
+            // 长度未知：先追加到末尾再转到目标位置
+            size_t old_size = size_;
+            append_range(first, last);
+            std::rotate(begin() + offset, begin() + old_size, end());
+            return begin() + offset;
+        }
+    }
 
-        // 批量构造新元素
-        std::uninitialized_copy(first, last, data_ + pos);
+    // 改变大小，新元素默认初始化（new T 而不是 new T()）：平凡类型不会被清零，
+    // 适合随后由调用者直接写入缓冲区的场景（如反序列化）
+    void resize_default_init(size_type new_size) {
+        if (new_size > capacity_) {
+            reserve(new_size);
+        }
+        for (size_t i = new_size; i < size_; ++i) {
+            allocator.destroy(data_ + i);
+        }
+        for (size_t i = size_; i < new_size; ++i) {
+            ::new(static_cast<void*>(data_ + i)) T;
+        }
+        size_ = new_size;
+    }
 
-        // 更新容器大小
-        size_ = newSize;
+    // 只改变大小、不初始化新元素，仅限平凡类型；读取前必须先写入
+    void resize_uninitialized(size_type new_size) {
+        static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                      "resize_uninitialized requires a trivial element type");
+        if (new_size > capacity_) {
+            reserve(new_size);
+        }
+        size_ = new_size;
     }
 
     //为向量对象保留最小的存储长度，必要时为其分配空间
     void reserve(size_t new_capacity) {
         if (new_capacity <= capacity_) return;
-        
-        T* new_data = allocator.allocate(new_capacity);
-        for (size_t i = 0; i < size_; ++i) {
-            allocator.construct(new_data + i, std::move(data_[i]));
-            allocator.destroy(data_ + i);
-        }
-        allocator.deallocate(data_, capacity_);
-        data_ = new_data;
-        capacity_ = new_capacity;
+        reallocate_storage(new_capacity);
     }
 
     // 为矢量指定新的大小
@@ -492,29 +660,573 @@ public:
     //放弃额外容量
     void shrink_to_fit(){
         if(size_ < capacity_){
-            pointer new_data = allocator.allocate(size_);
-            for(size_t i = 0; i < size_; i++){
-                allocator.construct(new_data + i, move(data_[i]));
-                allocator.destroy(data_ + i);
-            }
-            allocator.deallocate(data_, capacity_);
-            data_ = new_data;
-            capacity_ = size_;
+            reallocate_storage(size_);
         }
     }
 
     // 添加 swap 成员函数
-    void swap(Vector<T, Alloc>& other) {
+    void swap(Vector& other) {
         std::swap(data_, other.data_);
         std::swap(size_, other.size_);
         std::swap(capacity_, other.capacity_);
+        if constexpr (std::allocator_traits<Alloc>::propagate_on_container_swap::value) {
+            std::swap(allocator, other.allocator);
+        }
     }
 
 };
 
+// Vector 只持有指向堆的指针，使用无状态的默认分配器时整体可以按字节搬移
+template <typename T, typename Growth>
+struct Is_trivially_relocatable<Vector<T, Allocator<T>, Growth>> : std::true_type {};
+
 // 在 Vector 类外部定义非成员 swap 函数
-template <typename T, typename Alloc>
-void swap(Vector<T, Alloc>& left, Vector<T, Alloc>& right) {
+template <typename T, typename Alloc, typename Growth>
+void swap(Vector<T, Alloc, Growth>& left, Vector<T, Alloc, Growth>& right) {
+    left.swap(right);
+}
+
+// 带内联存储的 Vector：前 N 个元素放在对象内部，不向分配器申请内存，超过 N 个时整体搬到堆上。
+// 接口与 Vector 一致。对象内部存放元素，移动与交换需要逐个搬移内联元素，不再是 O(1)
+template <typename T, size_t N, typename Alloc = Allocator<T>, typename Growth = Growth_double>
+class Small_vector{
+    static_assert(N > 0, "Small_vector needs at least one inline element");
+
+private:
+    T* data_ = inline_data();
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    [[__no_unique_address__]] Alloc allocator;
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+
+    T* inline_data() noexcept {
+        return reinterpret_cast<T*>(inline_);
+    }
+
+    const T* inline_data() const noexcept {
+        return reinterpret_cast<const T*>(inline_);
+    }
+
+    // 把 n 个元素从 src 搬到未初始化的 dst，之后 src 处视为已销毁
+    void relocate_elements(T* dst, T* src, size_t n) {
+        if constexpr (Is_trivially_relocatable_v<T>) {
+            if (n) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                allocator.construct(dst + i, std::move(src[i]));
+                allocator.destroy(src + i);
+            }
+        }
+    }
+
+    // 归还堆上的存储（内联存储无需释放）
+    void dispose_storage() noexcept {
+        if (!is_inline()) {
+            allocator.deallocate(data_, capacity_);
+        }
+    }
+
+    // 换成容量为 new_capacity 的存储：不超过 N 时回到内联存储
+    void reallocate_storage(size_t new_capacity) {
+        if (new_capacity <= N) {
+            if (is_inline()) return;
+            relocate_elements(inline_data(), data_, size_);
+            allocator.deallocate(data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+            return;
+        }
+        T* new_data = allocator.allocate(new_capacity);
+        relocate_elements(new_data, data_, size_);
+        dispose_storage();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    // 至少容纳 min_capacity 个元素，按 Growth 预留余量
+    void expand_capacity(size_t min_capacity = 0) {
+        reserve(Growth::S_grow(capacity_, std::max(min_capacity, size_ + 1), sizeof(T)));
+    }
+
+    // 从 other 接管全部元素，other 变为空；调用前本对象为空且使用内联存储
+    void steal_from(Small_vector& other) {
+        if (other.is_inline()) {
+            relocate_elements(inline_data(), other.data_, other.size_);
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    // 构造函数用：追加 [first, last)，失败时释放已挪到堆上的存储（此时析构函数不会运行）
+    template <class InputIterator>
+    void construct_range(InputIterator first, InputIterator last) {
+        try {
+            append_range(first, last);
+        } catch (...) {
+            clear();
+            dispose_storage();
+            throw;
+        }
+    }
+
+    // 在未初始化的 dst 处构造 [first, last) 的 count 个副本
+    template <class ForwardIterator>
+    static void copy_range(T* dst, ForwardIterator first, ForwardIterator last, size_t count) {
+        using Source = typename std::remove_cv<typename std::remove_pointer<ForwardIterator>::type>::type;
+        if constexpr (std::is_pointer<ForwardIterator>::value && std::is_same<Source, T>::value &&
+                      std::is_trivially_copyable<T>::value) {
+            if (count) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(first), count * sizeof(T));
+            }
+        } else {
+            std::uninitialized_copy(first, last, dst);
+        }
+    }
+
+    // 在 offset 处插入 count 个由 fill(dst) 构造的元素，fill 抛异常时原内容不变
+    template <class Fill>
+    T* insert_with(size_t offset, size_t count, Fill fill) {
+        if (count == 0) {
+            return data_ + offset;
+        }
+        if (size_ + count > capacity_) {
+            size_t new_capacity = Growth::S_grow(capacity_, size_ + count, sizeof(T));
+            T* new_data = allocator.allocate(new_capacity);
+            try {
+                fill(new_data + offset);
+            } catch (...) {
+                allocator.deallocate(new_data, new_capacity);
+                throw;
+            }
+            relocate_elements(new_data, data_, offset);
+            relocate_elements(new_data + offset + count, data_ + offset, size_ - offset);
+            dispose_storage();
+            data_ = new_data;
+            capacity_ = new_capacity;
+        } else {
+            // 其后的元素从后往前逐个后移，腾出未初始化的位置
+            size_t tail = size_ - offset;
+            for (size_t i = tail; i > 0; --i) {
+                allocator.construct(data_ + offset + count + i - 1, std::move(data_[offset + i - 1]));
+                allocator.destroy(data_ + offset + i - 1);
+            }
+            try {
+                fill(data_ + offset);
+            } catch (...) {
+                for (size_t i = 0; i < tail; ++i) {
+                    allocator.construct(data_ + offset + i, std::move(data_[offset + count + i]));
+                    allocator.destroy(data_ + offset + count + i);
+                }
+                throw;
+            }
+        }
+        size_ += count;
+        return data_ + offset;
+    }
+
+public:
+
+    using allocator_type         = Alloc;
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using difference_type        = std::ptrdiff_t;
+    using value_type             = T;
+    using size_type              = size_t;
+
+    // 内联容量
+    static constexpr size_t inline_capacity = N;
+
+    Small_vector() noexcept(std::is_nothrow_default_constructible<Alloc>::value) {}
+
+    explicit Small_vector(const Alloc& allocator) : allocator(allocator) {}
+
+    explicit Small_vector(size_t size) {
+        resize(size);
+    }
+
+    Small_vector(size_t size, const T& value) {
+        insert(end(), size, value);
+    }
+
+    Small_vector(initializer_list<T> list) {
+        construct_range(list.begin(), list.end());
+    }
+
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    Small_vector(InputIterator first, InputIterator last) {
+        construct_range(first, last);
+    }
+
+    Small_vector(const Small_vector& other) : allocator(other.allocator) {
+        construct_range(other.begin(), other.end());
+    }
+
+    Small_vector(Small_vector&& other) noexcept(Is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible<T>::value)
+        : allocator(std::move(other.allocator)) {
+        steal_from(other);
+    }
+
+    ~Small_vector(){
+        clear();
+        dispose_storage();
+    }
+
+    Small_vector& operator=(const Small_vector& other) {
+        if (this == &other) return *this;
+        clear();
+        append_range(other.begin(), other.end());
+        return *this;
+    }
+
+    Small_vector& operator=(Small_vector&& other) {
+        if (this == &other) return *this;
+        clear();
+        dispose_storage();
+        data_ = inline_data();
+        capacity_ = N;
+        allocator = std::move(other.allocator);
+        steal_from(other);
+        return *this;
+    }
+
+    Small_vector& operator=(initializer_list<value_type> list) {
+        assign(list);
+        return *this;
+    }
+
+    // 元素当前是否存放在对象内部
+    bool is_inline() const noexcept {
+        return data_ == inline_data();
+    }
+
+    iterator begin() noexcept {
+        return data_;
+    }
+
+    const_iterator begin() const noexcept {
+        return data_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return data_;
+    }
+
+    iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(cend());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(cbegin());
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template <class... Types>
+    reference emplace_back(Types&&... args){
+        if (size_ == capacity_) {
+            // 参数可能引用容器内的元素，先构造出来再扩容
+            T value(std::forward<Types>(args)...);
+            expand_capacity();
+            allocator.construct(data_ + size_, std::move(value));
+        } else {
+            allocator.construct(data_ + size_, std::forward<Types>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void pop_back() {
+        if (size_ > 0) {
+            allocator.destroy(data_ + size_ - 1);
+            --size_;
+        }
+    }
+
+    reference back(){
+        return data_[size_ - 1];
+    }
+
+    const_reference back() const{
+        return data_[size_ - 1];
+    }
+
+    reference front(){
+        return *data_;
+    }
+
+    const_reference front() const{
+        return *data_;
+    }
+
+    T& operator[](size_t index) {
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const {
+        return data_[index];
+    }
+
+    reference at(size_type pos) {
+        if (pos >= size_) {
+            throw std::out_of_range("Small_vector::at");
+        }
+        return data_[pos];
+    }
+
+    const_reference at(size_type pos) const {
+        if (pos >= size_) {
+            throw std::out_of_range("Small_vector::at");
+        }
+        return data_[pos];
+    }
+
+    pointer data() noexcept {
+        return data_;
+    }
+
+    const_pointer data() const noexcept {
+        return data_;
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    void clear() noexcept {
+        for (size_t i = 0; i < size_; ++i) {
+            allocator.destroy(data_ + i);
+        }
+        size_ = 0;
+    }
+
+    iterator erase(const_iterator position){
+        size_t pos = position - cbegin();
+        std::move(begin() + pos + 1, end(), begin() + pos);
+        allocator.destroy(data_ + size_ - 1);
+        --size_;
+        return data_ + pos;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        size_t start_pos = first - cbegin();
+        size_t num_erase = last - first;
+        if (num_erase == 0) return data_ + start_pos;
+        std::move(begin() + start_pos + num_erase, end(), begin() + start_pos);
+        for (size_t i = size_ - num_erase; i < size_; ++i) {
+            allocator.destroy(data_ + i);
+        }
+        size_ -= num_erase;
+        return data_ + start_pos;
+    }
+
+    void assign(size_type count, const T& value){
+        clear();
+        insert(end(), count, value);
+    }
+
+    void assign(initializer_list<value_type> list){
+        clear();
+        append_range(list.begin(), list.end());
+    }
+
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void assign(InputIterator first, InputIterator last){
+        clear();
+        append_range(first, last);
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        size_t offset = pos - cbegin();
+        if (offset == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return data_ + offset;
+        }
+        T value(std::forward<Args>(args)...);
+        return insert_with(offset, 1, [&](T* dst) {
+            allocator.construct(dst, std::move(value));
+        });
+    }
+
+    allocator_type get_allocator() const{
+        return allocator;
+    }
+
+    iterator insert(const_iterator position, const value_type& value){
+        return emplace(position, value);
+    }
+
+    iterator insert(const_iterator position, T&& value) {
+        return emplace(position, std::move(value));
+    }
+
+    iterator insert(const_iterator position, size_type count, const T& value) {
+        T copy(value);
+        return insert_with(position - cbegin(), count, [&](T* dst) {
+            std::uninitialized_fill_n(dst, count, copy);
+        });
+    }
+
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    iterator insert(const_iterator position, InputIterator first, InputIterator last) {
+        return insert_range(position, first, last);
+    }
+
+    iterator insert(const_iterator position, initializer_list<value_type> list) {
+        return insert_range(position, list.begin(), list.end());
+    }
+
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void append_range(InputIterator first, InputIterator last) {
+        using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+        if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+            size_t count = static_cast<size_t>(std::distance(first, last));
+            if (size_ + count > capacity_) {
+                expand_capacity(size_ + count);
+            }
+            copy_range(data_ + size_, first, last, count);
+            size_ += count;
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    iterator insert_range(const_iterator position, InputIterator first, InputIterator last) {
+        size_t offset = position - cbegin();
+        using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+        if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+            if (offset == size_) {
+                append_range(first, last);
+                return data_ + offset;
+            }
+            size_t count = static_cast<size_t>(std::distance(first, last));
+            return insert_with(offset, count, [&](T* dst) {
+                copy_range(dst, first, last, count);
+            });
+        } else {
+            size_t old_size = size_;
+            append_range(first, last);
+            std::rotate(begin() + offset, begin() + old_size, end());
+            return data_ + offset;
+        }
+    }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity <= capacity_) return;
+        reallocate_storage(new_capacity);
+    }
+
+    void resize(size_type new_size) {
+        resize(new_size, T());
+    }
+
+    void resize(size_type new_size, const value_type& value) {
+        if (new_size < size_) {
+            erase(begin() + new_size, end());
+        } else {
+            insert(end(), new_size - size_, value);
+        }
+    }
+
+    void resize_default_init(size_type new_size) {
+        if (new_size > capacity_) {
+            reserve(new_size);
+        }
+        for (size_t i = new_size; i < size_; ++i) {
+            allocator.destroy(data_ + i);
+        }
+        for (size_t i = size_; i < new_size; ++i) {
+            ::new(static_cast<void*>(data_ + i)) T;
+        }
+        size_ = new_size;
+    }
+
+    void resize_uninitialized(size_type new_size) {
+        static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                      "resize_uninitialized requires a trivial element type");
+        if (new_size > capacity_) {
+            reserve(new_size);
+        }
+        size_ = new_size;
+    }
+
+    // 放弃额外容量：元素不超过 N 个时搬回内联存储
+    void shrink_to_fit(){
+        if (!is_inline() && size_ < capacity_) {
+            reallocate_storage(size_);
+        }
+    }
+
+    void swap(Small_vector& other) {
+        if (this == &other) return;
+        if (!is_inline() && !other.is_inline()) {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+            // 缓冲区换了主人，分配器要跟着走，否则之后会用另一个分配器释放或扩容（与内联分支的移动赋值一致）
+            if constexpr (std::allocator_traits<Alloc>::propagate_on_container_swap::value) {
+                std::swap(allocator, other.allocator);
+            }
+        } else {
+            Small_vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+    }
+
+};
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void swap(Small_vector<T, N, Alloc, Growth>& left, Small_vector<T, N, Alloc, Growth>& right) {
     left.swap(right);
 }
 
@@ -0,0 +1,364 @@
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include "allocator.h"
+#include "vector.h"
+#include "concurrent_queue.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Chase-Lev 工作窃取双端队列（Lê 等人针对弱内存模型给出的 C11 版本）。
+// 只有拥有者线程调用 push / try_pop，在底端后进先出；其他线程调用 try_steal，从顶端先进先出地偷取。
+// 环形数组装满时由拥有者翻倍扩容，旧数组可能还被窃取者读取，保留到析构时才释放。
+// 元素在线程间按值传递，要求可平凡复制且 atomic<T> 无锁（通常是任务指针）
+template <typename T, typename Alloc = Allocator<T>>
+class Work_stealing_deque{
+    static_assert(std::is_trivially_copyable<T>::value, "Work_stealing_deque requires a trivially copyable T");
+    static_assert(std::atomic<T>::is_always_lock_free, "Work_stealing_deque requires a lock-free atomic<T>");
+
+private:
+    struct Ring{
+        size_t           M_capacity;
+        size_t           M_mask;
+        std::atomic<T>*  M_slots;
+
+        T M_get(std::int64_t i) const noexcept {
+            return M_slots[static_cast<size_t>(i) & M_mask].load(std::memory_order_relaxed);
+        }
+
+        void M_put(std::int64_t i, T value) noexcept {
+            M_slots[static_cast<size_t>(i) & M_mask].store(value, std::memory_order_relaxed);
+        }
+    };
+
+    using Slot_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<std::atomic<T>>;
+    using Ring_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Ring>;
+
+public:
+    using value_type     = T;
+    using size_type      = size_t;
+    using allocator_type = Alloc;
+
+    // 初始容量向上取整到 2 的幂
+    explicit Work_stealing_deque(size_type capacity = 64, const Alloc& a = Alloc())
+        : M_slot_allocator(a), M_ring_allocator(a) {
+        M_ring.store(M_new_ring(Concurrent_queue_config::S_round_up(capacity)), std::memory_order_relaxed);
+    }
+
+    Work_stealing_deque(const Work_stealing_deque&) = delete;
+    Work_stealing_deque& operator=(const Work_stealing_deque&) = delete;
+
+    ~Work_stealing_deque() {
+        M_delete_ring(M_ring.load(std::memory_order_relaxed));
+        for (Ring* ring : M_retired) {
+            M_delete_ring(ring);
+        }
+    }
+
+    // ---------------- 拥有者 ----------------
+
+    void push(T value) {
+        std::int64_t b = M_bottom.load(std::memory_order_relaxed);
+        std::int64_t t = M_top.load(std::memory_order_acquire);
+        Ring* ring = M_ring.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(ring->M_capacity) - 1) {
+            ring = M_grow(ring, t, b);
+        }
+        ring->M_put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        M_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // 从底端取出最近压入的元素；只剩一个元素时与窃取者用 CAS 争夺
+    bool try_pop(T& out) {
+        std::int64_t b = M_bottom.load(std::memory_order_relaxed) - 1;
+        Ring* ring = M_ring.load(std::memory_order_relaxed);
+        M_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = M_top.load(std::memory_order_relaxed);
+        if (t > b) {
+            M_bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = ring->M_get(b);
+        if (t == b) {
+            bool won = M_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            M_bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // ---------------- 窃取者 ----------------
+
+    // 从顶端偷取最早压入的元素；为空或与其他线程冲突时返回 false
+    bool try_steal(T& out) {
+        std::int64_t t = M_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = M_bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        Ring* ring = M_ring.load(std::memory_order_acquire);
+        T value = ring->M_get(t);
+        if (!M_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    // ---------------- 观察 ----------------
+
+    // 并发修改时只是近似值
+    size_type size() const noexcept {
+        std::int64_t b = M_bottom.load(std::memory_order_relaxed);
+        std::int64_t t = M_top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_type>(b - t) : 0;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    size_type capacity() const noexcept {
+        return M_ring.load(std::memory_order_relaxed)->M_capacity;
+    }
+
+private:
+    Ring* M_new_ring(size_t capacity) {
+        std::atomic<T>* slots = M_slot_allocator.allocate(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            ::new (static_cast<void*>(slots + i)) std::atomic<T>();
+        }
+        Ring* ring = M_ring_allocator.allocate(1);
+        ::new (static_cast<void*>(ring)) Ring{capacity, capacity - 1, slots};
+        return ring;
+    }
+
+    void M_delete_ring(Ring* ring) noexcept {
+        M_slot_allocator.deallocate(ring->M_slots, ring->M_capacity);
+        M_ring_allocator.deallocate(ring, 1);
+    }
+
+    // 换成两倍容量的数组并拷入 [t, b)；旧数组可能正被窃取者读取，先挂起来
+    Ring* M_grow(Ring* ring, std::int64_t t, std::int64_t b) {
+        Ring* bigger = M_new_ring(ring->M_capacity * 2);
+        for (std::int64_t i = t; i < b; ++i) {
+            bigger->M_put(i, ring->M_get(i));
+        }
+        M_retired.push_back(ring);
+        M_ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    Slot_alloc_type M_slot_allocator;
+    Ring_alloc_type M_ring_allocator;
+    Vector<Ring*>   M_retired;      // 只有拥有者访问
+
+    alignas(Concurrent_queue_config::S_cache_line) std::atomic<std::int64_t> M_top{0};     // 窃取者竞争
+    alignas(Concurrent_queue_config::S_cache_line) std::atomic<std::int64_t> M_bottom{0};  // 拥有者写
+    alignas(Concurrent_queue_config::S_cache_line) std::atomic<Ring*>        M_ring{nullptr};
+};
+
+// 线程池中的任务：类型擦除后以指针在队列间传递，执行完由执行者释放
+struct Pool_task{
+    virtual void M_run() = 0;
+    virtual ~Pool_task() = default;
+};
+
+template <typename Func>
+struct Pool_task_impl : Pool_task{
+    Func M_func;
+
+    explicit Pool_task_impl(Func&& f) : M_func(std::move(f)) {}
+    explicit Pool_task_impl(const Func& f) : M_func(f) {}
+
+    void M_run() override {
+        M_func();
+    }
+};
+
+// 工作窃取线程池。
+// 每个工作线程有一个 Work_stealing_deque：工作线程内提交的任务压入自己的队列底端，
+// 外部线程提交的任务进入共享的 Mpmc_queue；空闲的工作线程依次查看自己的队列、共享队列，
+// 再随机挑选其他线程偷取，仍然没有任务时先自旋，之后在条件变量上休眠。
+// 析构时等待已提交的任务全部执行完。任务不应抛出异常（在工作线程中抛出会终止程序）
+class Thread_pool{
+public:
+    explicit Thread_pool(size_t threads = std::thread::hardware_concurrency())
+        : M_count(threads ? threads : 1),
+          M_deques(new Work_stealing_deque<Pool_task*>[M_count]),
+          M_injected(S_injected_capacity) {
+        M_threads.reserve(M_count);
+        for (size_t i = 0; i < M_count; ++i) {
+            M_threads.emplace_back([this, i] { M_worker_loop(i); });
+        }
+    }
+
+    Thread_pool(const Thread_pool&) = delete;
+    Thread_pool& operator=(const Thread_pool&) = delete;
+
+    ~Thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(M_mutex);
+            M_stop.store(true, std::memory_order_release);
+        }
+        M_wakeup.notify_all();
+        for (std::thread& t : M_threads) {
+            t.join();
+        }
+    }
+
+    size_t size() const noexcept {
+        return M_count;
+    }
+
+    // 提交一个无参任务，不等待其完成
+    template <typename Func>
+    void submit(Func&& f) {
+        using Task = Pool_task_impl<std::decay_t<Func>>;
+        M_push(new Task(std::forward<Func>(f)));
+    }
+
+    // 把 [first, last) 按 grain 个一段切开，对每段并行调用 f(begin, end)，全部完成后返回。
+    // 调用线程在等待期间也执行任务，工作线程内嵌套调用不会死锁
+    template <typename Func>
+    void parallel_for(size_t first, size_t last, size_t grain, Func f) {
+        if (first >= last) return;
+        grain = std::max<size_t>(grain, 1);
+        size_t chunks = (last - first + grain - 1) / grain;
+        std::atomic<size_t> remaining(chunks);
+        for (size_t c = 0; c < chunks; ++c) {
+            size_t begin = first + c * grain;
+            size_t end = std::min(last, begin + grain);
+            submit([&f, &remaining, begin, end] {
+                f(begin, end);
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        Spin_backoff backoff;
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            if (Pool_task* task = M_find_task(M_current_index())) {
+                M_run(task);
+                backoff.M_reset();
+            } else {
+                backoff.M_wait();
+            }
+        }
+    }
+
+private:
+    static constexpr size_t S_injected_capacity = 4096;   // 外部提交队列的容量
+    static constexpr size_t S_idle_rounds       = 256;    // 找不到任务时休眠前的尝试次数
+    static constexpr size_t S_npos              = static_cast<size_t>(-1);
+
+    // 当前线程所属的线程池与工作线程编号
+    struct Worker_slot{
+        const Thread_pool* M_pool;
+        size_t             M_index;
+    };
+
+    static Worker_slot& S_current() noexcept {
+        thread_local Worker_slot slot{nullptr, S_npos};
+        return slot;
+    }
+
+    size_t M_current_index() const noexcept {
+        const Worker_slot& slot = S_current();
+        return slot.M_pool == this ? slot.M_index : S_npos;
+    }
+
+    void M_push(Pool_task* task) {
+        M_pending.fetch_add(1, std::memory_order_seq_cst);
+        size_t index = M_current_index();
+        if (index != S_npos) {
+            M_deques[index].push(task);
+        } else {
+            M_injected.push(task);
+        }
+        if (M_sleepers.load(std::memory_order_seq_cst) != 0) {
+            std::lock_guard<std::mutex> lock(M_mutex);
+            M_wakeup.notify_one();
+        }
+    }
+
+    // 依次查看自己的队列、共享队列，再从其他工作线程偷取
+    Pool_task* M_find_task(size_t index) {
+        Pool_task* task = nullptr;
+        if (index != S_npos && M_deques[index].try_pop(task)) {
+            return M_take(task);
+        }
+        if (M_injected.try_pop(task)) {
+            return M_take(task);
+        }
+        size_t start = Concurrent_queue_config::S_random() % M_count;
+        for (size_t k = 0; k < M_count; ++k) {
+            size_t victim = (start + k) % M_count;
+            if (victim != index && M_deques[victim].try_steal(task)) {
+                return M_take(task);
+            }
+        }
+        return nullptr;
+    }
+
+    Pool_task* M_take(Pool_task* task) noexcept {
+        M_pending.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    static void M_run(Pool_task* task) {
+        task->M_run();
+        delete task;
+    }
+
+    void M_worker_loop(size_t index) {
+        S_current() = Worker_slot{this, index};
+        Spin_backoff backoff;
+        size_t idle = 0;
+        for (;;) {
+            if (Pool_task* task = M_find_task(index)) {
+                M_run(task);
+                backoff.M_reset();
+                idle = 0;
+                continue;
+            }
+            if (M_stop.load(std::memory_order_acquire) && M_pending.load(std::memory_order_acquire) == 0) {
+                break;
+            }
+            if (++idle < S_idle_rounds) {
+                backoff.M_wait();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(M_mutex);
+            M_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            M_wakeup.wait(lock, [this] {
+                return M_stop.load(std::memory_order_acquire) || M_pending.load(std::memory_order_seq_cst) != 0;
+            });
+            M_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+            backoff.M_reset();
+        }
+    }
+
+    const size_t                                     M_count;
+    std::unique_ptr<Work_stealing_deque<Pool_task*>[]> M_deques;
+    Mpmc_queue<Pool_task*>                           M_injected;
+    Vector<std::thread>                              M_threads;
+
+    alignas(Concurrent_queue_config::S_cache_line) std::atomic<size_t> M_pending{0};   // 已提交未取走的任务数
+    std::atomic<size_t>     M_sleepers{0};
+    std::atomic<bool>       M_stop{false};
+    std::mutex              M_mutex;
+    std::condition_variable M_wakeup;
+};
+
+#endif // WORK_STEALING_H